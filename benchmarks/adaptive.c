@@ -0,0 +1,122 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <arena.h>
+#include "bench.h"
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#define SUITE       "adaptive"
+#define CYCLES      2100u   // ends with quiet cycles after the last burst
+#define SPIKE_EVERY 250u        // every SPIKE_EVERY cycles a burst allocates much more than usual
+#define QUIET_SIZE  (16u * 1024u)
+#define SPIKE_SIZE  (8u * 1024u * 1024u)
+#define CHUNK       256u
+
+static size_t resident(void);
+
+static uint64_t run(bool adaptive, size_t *resizes, size_t *peakResident, size_t *finalResident);
+
+int main() {
+    const char *const backends[] = {"growable", "adaptive"};
+
+#if defined(__GLIBC__)
+    // a fixed threshold disables the dynamic one, which would keep freed blocks in the heap instead of unmapping them
+    mallopt(M_MMAP_THRESHOLD, 128 * 1024);
+#endif
+
+    for (size_t i = 0u; i < 2u; i++) {
+        size_t resizes, peakResident, finalResident;
+        Bench_report(SUITE, "bursty", backends[i], CYCLES, run(1u == i, &resizes, &peakResident, &finalResident));
+        fprintf(stderr, "%s: %s resizes=%zu peak resident=%zu KiB final resident=%zu KiB\n",
+                SUITE, backends[i], resizes, peakResident / 1024u, finalResident / 1024u);
+    }
+
+    return 0;
+}
+
+size_t resident(void) {
+    size_t pages = 0u;
+    FILE *const statm = fopen("/proc/self/statm", "r");
+
+    if (NULL != statm) {
+        if (1 != fscanf(statm, "%*s %zu", &pages)) {
+            pages = 0u;
+        }
+
+        fclose(statm);
+    }
+
+    return pages * (size_t) sysconf(_SC_PAGESIZE);
+}
+
+uint64_t run(const bool adaptive, size_t *const resizes, size_t *const peakResident, size_t *const finalResident) {
+    const size_t baseline = resident();
+    struct Arena *const arena = Arena_withConfig(&(struct ArenaConfig) {
+            .capacity = 4096u,
+            .growable = true,
+            .zeroing = ARENA_ZERO_NEVER,
+            .adaptive = adaptive,
+    });
+    size_t capacity = Arena_capacity(arena);
+    *resizes = 0u;
+    *peakResident = 0u;
+    const uint64_t start = Bench_now();
+
+    for (size_t cycle = 1u; cycle <= CYCLES; cycle++) {
+        const size_t size = 0u == cycle % SPIKE_EVERY ? SPIKE_SIZE : QUIET_SIZE;
+
+        for (size_t allocated = 0u; allocated < size; allocated += CHUNK) {
+            // touch the memory so that it counts as resident
+            memset(Arena_allocate(arena, 8u, CHUNK), 1, CHUNK);
+        }
+
+        if (size == SPIKE_SIZE) {
+            const size_t current = resident();
+            *peakResident = current > *peakResident ? current : *peakResident;
+        }
+
+        Arena_clear(arena);
+
+        if (capacity != Arena_capacity(arena)) {
+            capacity = Arena_capacity(arena);
+            *resizes += 1u;
+        }
+    }
+
+    const uint64_t elapsed = Bench_now() - start;
+    const size_t current = resident();
+    *peakResident = (current > *peakResident ? current : *peakResident) - baseline;
+    *finalResident = current > baseline ? current - baseline : 0u;
+    Arena_drop(arena);
+    return elapsed;
+}
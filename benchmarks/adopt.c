@@ -0,0 +1,128 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdalign.h>
+#include <arena.h>
+#include "bench.h"
+
+#define SUITE       "adopt"
+#define RESULTS     4000000u
+
+// a result as produced by a worker: a linked list node carrying its payload
+struct Result {
+    struct Result *next;
+    size_t key;
+    double payload[6];
+};
+
+static struct Arena *newArena(void);
+
+static struct Result *produce(struct Arena *arena, size_t count);
+
+static uint64_t clone(size_t count);
+
+static uint64_t adopt(size_t count);
+
+int main() {
+    Bench_report(SUITE, "results-1k", "clone", RESULTS, clone(1000u));
+    Bench_report(SUITE, "results-1k", "adopt", RESULTS, adopt(1000u));
+    Bench_report(SUITE, "results-100k", "clone", RESULTS, clone(100000u));
+    Bench_report(SUITE, "results-100k", "adopt", RESULTS, adopt(100000u));
+    return 0;
+}
+
+struct Arena *newArena(void) {
+    return Arena_withConfig(&(struct ArenaConfig) {
+            .capacity = 64u * 1024u,
+            .maxBlockCapacity = 1024u * 1024u,
+            .growable = true,
+            .zeroing = ARENA_ZERO_NEVER,
+    });
+}
+
+struct Result *produce(struct Arena *const arena, const size_t count) {
+    struct Result *head = NULL;
+
+    for (size_t i = 0u; i < count; i++) {
+        struct Result *const result = Arena_make(arena, struct Result);
+        result->next = head;
+        result->key = i;
+        for (size_t j = 0u; j < 6u; j++) {
+            result->payload[j] = (double) (i + j);
+        }
+        head = result;
+    }
+
+    return head;
+}
+
+// the handoff and the release are timed: the consumer copies the results, then both arenas are released
+uint64_t clone(const size_t count) {
+    struct Arena *const consumer = newArena();
+    uint64_t elapsed = 0u;
+
+    for (size_t round = 0u; round < RESULTS / count; round++) {
+        struct Arena *const producer = newArena();
+        const struct Result *results = produce(producer, count);
+        const uint64_t start = Bench_now();
+        struct Result *head = NULL;
+        struct Result **tail = &head;
+
+        for (; NULL != results; results = results->next) {
+            struct Result *const result = Arena_clone(consumer, results, alignof(struct Result), sizeof(*results));
+            *tail = result;
+            tail = &result->next;
+        }
+
+        Bench_consume(head);
+        Arena_drop(producer);
+        Arena_clear(consumer);
+        elapsed += Bench_now() - start;
+    }
+
+    Arena_drop(consumer);
+    return elapsed;
+}
+
+// the handoff and the release are timed: the consumer takes the producer arena as it is and releases both
+uint64_t adopt(const size_t count) {
+    struct Arena *const consumer = newArena();
+    uint64_t elapsed = 0u;
+
+    for (size_t round = 0u; round < RESULTS / count; round++) {
+        struct Arena *const producer = newArena();
+        const struct Result *const head = produce(producer, count);
+        const uint64_t start = Bench_now();
+        Arena_adopt(consumer, producer);
+        Bench_consume(head);
+        Arena_clear(consumer);
+        elapsed += Bench_now() - start;
+    }
+
+    Arena_drop(consumer);
+    return elapsed;
+}
@@ -0,0 +1,65 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <arena.h>
+#include "bench.h"
+
+#define OPERATIONS  100000u
+
+static const size_t sizes[] = {8u, 24u, 40u, 100u, 256u, 1000u};
+
+int main() {
+    for (size_t alignment = 8u; alignment <= ARENA_MAX_ALIGNMENT; alignment *= 2u) {
+        struct Arena *const arena = Arena_withConfig(&(struct ArenaConfig) {
+                .capacity = 1024u * 1024u,
+                .growable = true,
+                .zeroing = ARENA_ZERO_NEVER,
+        });
+        size_t requested = 0u;
+        const uint64_t start = Bench_now();
+
+        for (size_t i = 0u; i < OPERATIONS; i++) {
+            const size_t size = sizes[i % (sizeof(sizes) / sizeof(sizes[0]))];
+            Bench_consume(Arena_allocate(arena, alignment, size));
+            requested += size;
+        }
+
+        const uint64_t elapsed = Bench_now() - start;
+        // includes the unused tails of the blocks left behind by the growth
+        const size_t slop = Arena_size(arena) - requested;
+        char workload[32];
+        snprintf(workload, sizeof(workload), "align-%zu", alignment);
+        Bench_report("alignment", workload, "arena", OPERATIONS, elapsed);
+        // the waste goes on stderr to keep the machine-readable output intact
+        fprintf(stderr, "%-12s %-18s %14zu bytes of slop (%.1f%%)\n", "alignment", workload, slop,
+                100.0 * (double) slop / (double) Arena_size(arena));
+        Arena_drop(arena);
+    }
+
+    return 0;
+}
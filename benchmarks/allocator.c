@@ -0,0 +1,228 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arena.h>
+#include "bench.h"
+
+#define SUITE       "allocator"
+#define OPERATIONS  1000000u
+#define BATCH       4096u
+#define CYCLE       256u
+
+static const size_t mixedSizes[] = {8u, 24u, 3u, 64u, 200u, 16u, 1000u, 40u};
+static const size_t mixedAlignments[] = {8u, 8u, 1u, 16u, 32u, 4u, 64u, 8u};
+static const char *const strings[] = {
+        "id", "identifier", "a slightly longer string literal", "x",
+        "GET /index.html HTTP/1.1", "Content-Type: application/json", "true", "null",
+};
+
+#define countOf(array)  (sizeof(array) / sizeof((array)[0]))
+
+static void *pointers[BATCH];
+
+static struct Arena *newArena(void);
+
+static void tiny(void);
+
+static void mixed(void);
+
+static void clone(void);
+
+static void reuse(void);
+
+int main() {
+    tiny();
+    mixed();
+    clone();
+    reuse();
+    return 0;
+}
+
+/*
+ * Tiny fixed-size allocations released in batches.
+ */
+void tiny(void) {
+    struct Arena *const arena = newArena();
+    uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        Bench_consume(Arena_allocate(arena, alignof(max_align_t), 16u));
+
+        if (BATCH - 1u == i % BATCH) {
+            Arena_clear(arena);
+        }
+    }
+
+    Bench_report(SUITE, "tiny", "arena", OPERATIONS, Bench_now() - start);
+    Arena_drop(arena);
+    start = Bench_now();
+
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        Bench_consume(pointers[i % BATCH] = malloc(16u));
+
+        if (BATCH - 1u == i % BATCH) {
+            for (size_t j = 0u; j < BATCH; j++) {
+                free(pointers[j]);
+            }
+        }
+    }
+
+    for (size_t j = 0u; j < OPERATIONS % BATCH; j++) {
+        free(pointers[j]);
+    }
+
+    Bench_report(SUITE, "tiny", "malloc", OPERATIONS, Bench_now() - start);
+}
+
+/*
+ * Mixed sizes and alignments released in batches.
+ */
+void mixed(void) {
+    struct Arena *const arena = newArena();
+    uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        const size_t k = i % countOf(mixedSizes);
+        Bench_consume(Arena_allocate(arena, mixedAlignments[k], mixedSizes[k]));
+
+        if (BATCH - 1u == i % BATCH) {
+            Arena_clear(arena);
+        }
+    }
+
+    Bench_report(SUITE, "mixed", "arena", OPERATIONS, Bench_now() - start);
+    Arena_drop(arena);
+    start = Bench_now();
+
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        const size_t k = i % countOf(mixedSizes);
+        const size_t alignment = mixedAlignments[k], size = mixedSizes[k];
+        void *const memory = alignment <= alignof(max_align_t) ? malloc(size)
+                                                               : aligned_alloc(alignment, (size + alignment - 1u) & ~(alignment - 1u));
+        Bench_consume(pointers[i % BATCH] = memory);
+
+        if (BATCH - 1u == i % BATCH) {
+            for (size_t j = 0u; j < BATCH; j++) {
+                free(pointers[j]);
+            }
+        }
+    }
+
+    for (size_t j = 0u; j < OPERATIONS % BATCH; j++) {
+        free(pointers[j]);
+    }
+
+    Bench_report(SUITE, "mixed", "malloc", OPERATIONS, Bench_now() - start);
+}
+
+/*
+ * Clone-heavy string copying released in batches.
+ */
+void clone(void) {
+    size_t lengths[countOf(strings)];
+    struct Arena *const arena = newArena();
+
+    for (size_t k = 0u; k < countOf(strings); k++) {
+        lengths[k] = strlen(strings[k]) + 1u;
+    }
+
+    uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        const size_t k = i % countOf(strings);
+        Bench_consume(Arena_clone(arena, strings[k], 1u, lengths[k]));
+
+        if (BATCH - 1u == i % BATCH) {
+            Arena_clear(arena);
+        }
+    }
+
+    Bench_report(SUITE, "clone", "arena", OPERATIONS, Bench_now() - start);
+    Arena_drop(arena);
+    start = Bench_now();
+
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        const size_t k = i % countOf(strings);
+        Bench_consume(pointers[i % BATCH] = memcpy(malloc(lengths[k]), strings[k], lengths[k]));
+
+        if (BATCH - 1u == i % BATCH) {
+            for (size_t j = 0u; j < BATCH; j++) {
+                free(pointers[j]);
+            }
+        }
+    }
+
+    for (size_t j = 0u; j < OPERATIONS % BATCH; j++) {
+        free(pointers[j]);
+    }
+
+    Bench_report(SUITE, "clone", "malloc", OPERATIONS, Bench_now() - start);
+}
+
+/*
+ * Short request-like cycles: a handful of allocations followed by a clear.
+ */
+void reuse(void) {
+    const size_t cycles = OPERATIONS / CYCLE;
+    struct Arena *const arena = newArena();
+    uint64_t start = Bench_now();
+
+    for (size_t cycle = 0u; cycle < cycles; cycle++) {
+        for (size_t i = 0u; i < CYCLE; i++) {
+            Bench_consume(Arena_allocate(arena, 8u, mixedSizes[i % countOf(mixedSizes)]));
+        }
+
+        Arena_clear(arena);
+    }
+
+    Bench_report(SUITE, "clear-reuse", "arena", cycles * CYCLE, Bench_now() - start);
+    Arena_drop(arena);
+    start = Bench_now();
+
+    for (size_t cycle = 0u; cycle < cycles; cycle++) {
+        for (size_t i = 0u; i < CYCLE; i++) {
+            Bench_consume(pointers[i] = malloc(mixedSizes[i % countOf(mixedSizes)]));
+        }
+
+        for (size_t i = 0u; i < CYCLE; i++) {
+            free(pointers[i]);
+        }
+    }
+
+    Bench_report(SUITE, "clear-reuse", "malloc", cycles * CYCLE, Bench_now() - start);
+}
+
+struct Arena *newArena(void) {
+    return Arena_withConfig(&(struct ArenaConfig) {
+            .capacity = 64u * 1024u,
+            .growable = true,
+            .zeroing = ARENA_ZERO_NEVER,
+    });
+}
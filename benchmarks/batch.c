@@ -0,0 +1,97 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <arena.h>
+#include "bench.h"
+
+#define SUITE       "batch"
+#define RECORDS     1000000u
+
+#define countOf(array)  (sizeof(array) / sizeof((array)[0]))
+
+// the fields of a record: a header, a name, a small vector of doubles, flags and a trailing buffer
+static const struct ArenaRequest record[] = {
+        {.alignment = 8u, .size = 24u},
+        {.alignment = 1u, .size = 13u},
+        {.alignment = 16u, .size = 64u},
+        {.alignment = 4u, .size = 4u},
+        {.alignment = 8u, .size = 40u},
+};
+
+static struct Arena *newArena(void);
+
+static uint64_t individual(void);
+
+static uint64_t batch(void);
+
+int main() {
+    Bench_report(SUITE, "record", "single", RECORDS, individual());
+    Bench_report(SUITE, "record", "batch", RECORDS, batch());
+    return 0;
+}
+
+struct Arena *newArena(void) {
+    return Arena_withConfig(&(struct ArenaConfig) {
+            .capacity = 64u * 1024u,
+            .maxBlockCapacity = 64u * 1024u,
+            .growable = true,
+            .zeroing = ARENA_ZERO_NEVER,
+    });
+}
+
+uint64_t individual(void) {
+    struct Arena *const arena = newArena();
+    void *fields[countOf(record)];
+    const uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < RECORDS; i++) {
+        for (size_t j = 0u; j < countOf(record); j++) {
+            fields[j] = Arena_allocate(arena, record[j].alignment, record[j].size);
+        }
+
+        Bench_consume(fields);
+    }
+
+    const uint64_t elapsed = Bench_now() - start;
+    Arena_drop(arena);
+    return elapsed;
+}
+
+uint64_t batch(void) {
+    struct Arena *const arena = newArena();
+    void *fields[countOf(record)];
+    const uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < RECORDS; i++) {
+        Arena_allocateBatch(arena, record, countOf(record), fields);
+        Bench_consume(fields);
+    }
+
+    const uint64_t elapsed = Bench_now() - start;
+    Arena_drop(arena);
+    return elapsed;
+}
@@ -0,0 +1,84 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Gets a monotonic timestamp in nanoseconds.
+ */
+static inline uint64_t Bench_now(void) {
+    struct timespec timespec;
+    clock_gettime(CLOCK_MONOTONIC, &timespec);
+    return ((uint64_t) timespec.tv_sec) * 1000000000u + ((uint64_t) timespec.tv_nsec);
+}
+
+/**
+ * Prevents the compiler from optimizing away the computation of value.
+ */
+static inline void Bench_consume(const void *const value) {
+    __asm__ volatile("" : : "g"(value) : "memory");
+}
+
+/**
+ * Reports the outcome of a workload on stdout.
+ * If the environment variable BENCH_FORMAT is set to csv a machine-readable line is printed
+ * using the columns: suite,workload,backend,operations,ns_per_op,ops_per_sec
+ */
+static inline void Bench_report(const char *const suite, const char *const workload, const char *const backend,
+                                const size_t operations, const uint64_t elapsed) {
+    assert(NULL != suite);
+    assert(NULL != workload);
+    assert(NULL != backend);
+    assert(operations > 0u);
+    const char *const format = getenv("BENCH_FORMAT");
+    const double nanosecondsPerOperation = (double) elapsed / (double) operations;
+    const double operationsPerSecond = 0u == elapsed ? 0.0 : 1e9 * (double) operations / (double) elapsed;
+
+    if (NULL != format && 0 == strcmp("csv", format)) {
+        printf("%s,%s,%s,%zu,%.3f,%.0f\n",
+               suite, workload, backend, operations, nanosecondsPerOperation, operationsPerSecond);
+    } else {
+        printf("%-12s %-18s %-8s %12.2f ns/op %16.0f ops/s\n",
+               suite, workload, backend, nanosecondsPerOperation, operationsPerSecond);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,27 @@
+message("benchmarks@${CMAKE_CURRENT_LIST_DIR} using: ${CMAKE_CURRENT_LIST_FILE}")
+
+find_package(Threads REQUIRED)
+
+# every source file is a standalone benchmark, the bench target runs all of them
+add_custom_target(bench)
+file(GLOB BENCHMARK_SOURCES ${CMAKE_CURRENT_LIST_DIR}/*.c)
+
+# C++ benchmarks are built only if a C++17 compiler is available
+include(CheckLanguage)
+check_language(CXX)
+if (CMAKE_CXX_COMPILER)
+    enable_language(CXX)
+    set(CMAKE_CXX_STANDARD 17)
+    set(CMAKE_CXX_STANDARD_REQUIRED ON)
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -Wall -Wextra -Werror")
+    file(GLOB BENCHMARK_CXX_SOURCES ${CMAKE_CURRENT_LIST_DIR}/*.cpp)
+    list(APPEND BENCHMARK_SOURCES ${BENCHMARK_CXX_SOURCES})
+endif ()
+
+foreach (BENCHMARK_SOURCE ${BENCHMARK_SOURCES})
+    get_filename_component(BENCHMARK_NAME ${BENCHMARK_SOURCE} NAME_WE)
+    add_executable(bench_${BENCHMARK_NAME} ${BENCHMARK_SOURCE})
+    target_link_libraries(bench_${BENCHMARK_NAME} PRIVATE arena Threads::Threads)
+    add_custom_command(TARGET bench POST_BUILD COMMAND bench_${BENCHMARK_NAME} VERBATIM)
+    add_dependencies(bench bench_${BENCHMARK_NAME})
+endforeach ()
@@ -0,0 +1,105 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <arena.h>
+#include "bench.h"
+
+#define ROUNDS          64u
+#define ALLOCATION_SIZE 64u
+#define BATCH_BYTES     (64u * 1024u * 1024u)   // dirty memory cleared by every timed batch
+#define MIN_BATCH       8u
+#define MAX_BATCH       1024u
+
+static const char *const zeroingNames[] = {
+        [ARENA_ZERO_ON_CLEAR] = "on-clear",
+        [ARENA_ZERO_NEVER] = "never",
+        [ARENA_ZERO_ON_ALLOCATE] = "on-alloc",
+};
+
+static size_t batchSize(size_t highWaterMark);
+
+static uint64_t measureClear(enum ArenaZeroing zeroing, size_t highWaterMark, size_t batch);
+
+int main() {
+    for (enum ArenaZeroing zeroing = ARENA_ZERO_ON_CLEAR; zeroing <= ARENA_ZERO_ON_ALLOCATE; zeroing++) {
+        for (size_t highWaterMark = 4096u; highWaterMark <= 8u * 1024u * 1024u; highWaterMark *= 8u) {
+            const size_t batch = batchSize(highWaterMark);
+            char workload[32];
+            snprintf(workload, sizeof(workload), "clear-%zu", highWaterMark);
+            Bench_report("clear", workload, zeroingNames[zeroing], ROUNDS * batch,
+                         measureClear(zeroing, highWaterMark, batch));
+        }
+    }
+
+    return 0;
+}
+
+// enough arenas for the timer overhead to be negligible, without holding too much memory for big high-water marks
+size_t batchSize(const size_t highWaterMark) {
+    const size_t batch = BATCH_BYTES / highWaterMark;
+    return batch < MIN_BATCH ? MIN_BATCH : batch > MAX_BATCH ? MAX_BATCH : batch;
+}
+
+// every clear needs a dirty arena: a batch of arenas is filled up to the high-water mark, then they are cleared in a row
+uint64_t measureClear(const enum ArenaZeroing zeroing, const size_t highWaterMark, const size_t batch) {
+    struct Arena **const arenas = malloc(batch * sizeof(*arenas));
+    uint64_t elapsed = 0u;
+
+    if (NULL == arenas) {
+        abort();
+    }
+
+    for (size_t i = 0u; i < batch; i++) {
+        arenas[i] = Arena_withConfig(&(struct ArenaConfig) {
+                .capacity = highWaterMark,
+                .zeroing = zeroing,
+        });
+    }
+
+    for (size_t round = 0u; round < ROUNDS; round++) {
+        for (size_t i = 0u; i < batch; i++) {
+            for (size_t size = 0u; size < highWaterMark; size += ALLOCATION_SIZE) {
+                Bench_consume(Arena_allocate(arenas[i], 1u, ALLOCATION_SIZE));
+            }
+        }
+
+        const uint64_t start = Bench_now();
+        for (size_t i = 0u; i < batch; i++) {
+            Arena_clear(arenas[i]);
+        }
+        elapsed += Bench_now() - start;
+    }
+
+    for (size_t i = 0u; i < batch; i++) {
+        Arena_drop(arenas[i]);
+    }
+
+    free(arenas);
+    return elapsed;
+}
@@ -0,0 +1,249 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <arena.h>
+#include <compact.h>
+#include "bench.h"
+
+#define SUITE       "compact"
+#define NODES       (1u << 20u)
+#define PASSES      16u
+
+// the graphs are built incrementally, interleaved with dead scratch data of random size
+struct ListNode {
+    struct ListNode *next;
+    uint64_t value;
+};
+
+struct TreeNode {
+    struct TreeNode *left;
+    struct TreeNode *right;
+    uint64_t key;
+    uint64_t value;
+};
+
+static const struct ArenaType listType;
+
+static const struct ArenaField listFields[] = {
+        {.offset = offsetof(struct ListNode, next), .type = &listType},
+};
+
+static const struct ArenaType listType = {
+        .alignment = alignof(struct ListNode),
+        .size = sizeof(struct ListNode),
+        .length = 1u,
+        .fields = listFields,
+};
+
+static const struct ArenaType treeType;
+
+static const struct ArenaField treeFields[] = {
+        {.offset = offsetof(struct TreeNode, left), .type = &treeType},
+        {.offset = offsetof(struct TreeNode, right), .type = &treeType},
+};
+
+static const struct ArenaType treeType = {
+        .alignment = alignof(struct TreeNode),
+        .size = sizeof(struct TreeNode),
+        .length = 2u,
+        .fields = treeFields,
+};
+
+static uint64_t random64(void);
+
+static struct Arena *newArena(void);
+
+static struct ListNode *buildList(struct Arena *arena);
+
+static struct TreeNode *buildTree(struct Arena *arena);
+
+static uint64_t walkList(const struct ListNode *head);
+
+static uint64_t walkTree(const struct TreeNode *root, const struct TreeNode **stack);
+
+static void list(void);
+
+static void tree(void);
+
+int main() {
+    list();
+    tree();
+    return 0;
+}
+
+uint64_t random64(void) {
+    static uint64_t state = 0x9e3779b97f4a7c15u;
+    state ^= state << 13u;
+    state ^= state >> 7u;
+    state ^= state << 17u;
+    return state;
+}
+
+struct Arena *newArena(void) {
+    return Arena_withConfig(&(struct ArenaConfig) {
+            .capacity = 64u * 1024u,
+            .maxBlockCapacity = 1024u * 1024u,
+            .growable = true,
+            .zeroing = ARENA_ZERO_NEVER,
+    });
+}
+
+struct ListNode *buildList(struct Arena *const arena) {
+    struct ListNode **const nodes = malloc(NODES * sizeof(*nodes));
+    assert(NULL != nodes);
+
+    for (size_t i = 0u; i < NODES; i++) {
+        nodes[i] = Arena_make(arena, struct ListNode);
+        nodes[i]->value = i;
+        Bench_consume(Arena_allocate(arena, 1u, 16u + random64() % 240u));
+    }
+
+    // the nodes are linked in shuffled order, as if they were inserted at random positions over time
+    for (size_t i = NODES - 1u; i > 0u; i--) {
+        const size_t j = random64() % (i + 1u);
+        struct ListNode *const node = nodes[i];
+        nodes[i] = nodes[j];
+        nodes[j] = node;
+    }
+
+    for (size_t i = 0u; i < NODES; i++) {
+        nodes[i]->next = i + 1u < NODES ? nodes[i + 1u] : NULL;
+    }
+
+    struct ListNode *const head = nodes[0];
+    free(nodes);
+    return head;
+}
+
+struct TreeNode *buildTree(struct Arena *const arena) {
+    struct TreeNode *root = NULL;
+
+    for (size_t i = 0u; i < NODES; i++) {
+        struct TreeNode *const node = Arena_make(arena, struct TreeNode);
+        node->left = node->right = NULL;
+        node->key = random64();
+        node->value = i;
+        Bench_consume(Arena_allocate(arena, 1u, 16u + random64() % 240u));
+
+        struct TreeNode **link = &root;
+        while (NULL != *link) {
+            link = node->key < (*link)->key ? &(*link)->left : &(*link)->right;
+        }
+        *link = node;
+    }
+
+    return root;
+}
+
+uint64_t walkList(const struct ListNode *head) {
+    uint64_t sum = 0u;
+
+    for (; NULL != head; head = head->next) {
+        sum += head->value;
+    }
+
+    return sum;
+}
+
+uint64_t walkTree(const struct TreeNode *const root, const struct TreeNode **const stack) {
+    uint64_t sum = 0u;
+    size_t length = 0u;
+    stack[length++] = root;
+
+    while (length > 0u) {
+        const struct TreeNode *const node = stack[--length];
+        sum += node->value;
+        if (NULL != node->right) {
+            stack[length++] = node->right;
+        }
+        if (NULL != node->left) {
+            stack[length++] = node->left;
+        }
+    }
+
+    return sum;
+}
+
+void list(void) {
+    struct Arena *const arena = newArena();
+    const struct ListNode *const head = buildList(arena);
+    void *compacted;
+    uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < PASSES; i++) {
+        const uint64_t sum = walkList(head);
+        Bench_consume(&sum);
+    }
+
+    Bench_report(SUITE, "list-walk", "fragmented", PASSES * NODES, Bench_now() - start);
+    start = Bench_now();
+    struct Arena *const compactedArena = Arena_compact(&listType, head, &compacted);
+    Bench_report(SUITE, "list-copy", "compact", NODES, Bench_now() - start);
+    Arena_drop(arena);
+    start = Bench_now();
+
+    for (size_t i = 0u; i < PASSES; i++) {
+        const uint64_t sum = walkList(compacted);
+        Bench_consume(&sum);
+    }
+
+    Bench_report(SUITE, "list-walk", "compacted", PASSES * NODES, Bench_now() - start);
+    Arena_drop(compactedArena);
+}
+
+void tree(void) {
+    struct Arena *const arena = newArena();
+    const struct TreeNode *const root = buildTree(arena);
+    const struct TreeNode **const stack = malloc(NODES * sizeof(*stack));
+    assert(NULL != stack);
+    void *compacted;
+    uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < PASSES; i++) {
+        const uint64_t sum = walkTree(root, stack);
+        Bench_consume(&sum);
+    }
+
+    Bench_report(SUITE, "tree-walk", "fragmented", PASSES * NODES, Bench_now() - start);
+    start = Bench_now();
+    struct Arena *const compactedArena = Arena_compact(&treeType, root, &compacted);
+    Bench_report(SUITE, "tree-copy", "compact", NODES, Bench_now() - start);
+    Arena_drop(arena);
+    start = Bench_now();
+
+    for (size_t i = 0u; i < PASSES; i++) {
+        const uint64_t sum = walkTree(compacted, stack);
+        Bench_consume(&sum);
+    }
+
+    Bench_report(SUITE, "tree-walk", "compacted", PASSES * NODES, Bench_now() - start);
+    Arena_drop(compactedArena);
+    free(stack);
+}
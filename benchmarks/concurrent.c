@@ -0,0 +1,118 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdalign.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <arena.h>
+#include <concurrent_arena.h>
+#include "bench.h"
+
+#define OPERATIONS      250000u
+#define ALLOCATION_SIZE 24u
+#define MAX_THREADS     64u
+
+struct Shared {
+    pthread_mutex_t mutex;
+    struct Arena *arena;
+    struct ConcurrentArena *concurrentArena;
+};
+
+static void *lockedWorker(void *argument);
+
+static void *concurrentWorker(void *argument);
+
+static uint64_t run(void *(*worker)(void *), struct Shared *shared, size_t threads);
+
+int main() {
+    const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    const size_t maxThreads = processors < 4 ? 4u : processors > (long) MAX_THREADS ? MAX_THREADS : (size_t) processors;
+    const size_t capacity = maxThreads * OPERATIONS * (ALLOCATION_SIZE + alignof(max_align_t));
+    struct Shared shared = {
+            .arena = Arena_withConfig(&(struct ArenaConfig) {.capacity = capacity, .zeroing = ARENA_ZERO_NEVER}),
+            .concurrentArena = ConcurrentArena_withCapacity(capacity),
+    };
+    pthread_mutex_init(&shared.mutex, NULL);
+
+    for (size_t threads = 1u; threads <= maxThreads; threads *= 2u) {
+        char workload[32];
+        snprintf(workload, sizeof(workload), "threads-%zu", threads);
+        Bench_report("concurrent", workload, "mutex", threads * OPERATIONS, run(lockedWorker, &shared, threads));
+        Bench_report("concurrent", workload, "atomic", threads * OPERATIONS, run(concurrentWorker, &shared, threads));
+        Arena_clear(shared.arena);
+        ConcurrentArena_clear(shared.concurrentArena);
+    }
+
+    pthread_mutex_destroy(&shared.mutex);
+    ConcurrentArena_drop(shared.concurrentArena);
+    Arena_drop(shared.arena);
+    return 0;
+}
+
+void *lockedWorker(void *const argument) {
+    struct Shared *const shared = argument;
+
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        pthread_mutex_lock(&shared->mutex);
+        void *const memory = Arena_allocate(shared->arena, alignof(max_align_t), ALLOCATION_SIZE);
+        pthread_mutex_unlock(&shared->mutex);
+        Bench_consume(memory);
+    }
+
+    return NULL;
+}
+
+void *concurrentWorker(void *const argument) {
+    struct Shared *const shared = argument;
+
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        Bench_consume(ConcurrentArena_allocate(shared->concurrentArena, alignof(max_align_t), ALLOCATION_SIZE));
+    }
+
+    return NULL;
+}
+
+uint64_t run(void *(*const worker)(void *), struct Shared *const shared, const size_t threads) {
+    assert(threads <= MAX_THREADS);
+    pthread_t handles[MAX_THREADS];
+    const uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < threads; i++) {
+        if (0 != pthread_create(&handles[i], NULL, worker, shared)) {
+            abort();
+        }
+    }
+
+    for (size_t i = 0u; i < threads; i++) {
+        pthread_join(handles[i], NULL);
+    }
+
+    return Bench_now() - start;
+}
@@ -0,0 +1,231 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdalign.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arena.h>
+#include <containers.h>
+#include "bench.h"
+
+#define VECTOR_OPERATIONS   1000000u
+#define STRING_OPERATIONS   1000000u
+#define MAP_OPERATIONS      200000u
+
+/*
+ * The same structures built on malloc/realloc/free
+ */
+
+struct HeapMapEntry {
+    uint64_t hash;
+    void *key;
+    size_t keySize;
+    void *value;
+};
+
+struct HeapMap {
+    struct HeapMapEntry *entries;
+    size_t length;
+    size_t capacity;
+};
+
+static struct HeapMapEntry *HeapMap_probe(struct HeapMapEntry *entries, size_t capacity, uint64_t hash,
+                                          const void *key, size_t keySize);
+
+static void HeapMap_put(struct HeapMap *self, const void *key, size_t keySize, void *value);
+
+static void **HeapMap_get(const struct HeapMap *self, const void *key, size_t keySize);
+
+static void HeapMap_drop(struct HeapMap *self);
+
+int main() {
+    char key[32];
+    uint64_t start;
+
+    // vector of ints
+    {
+        struct Arena *const arena = Arena_withConfig(&(struct ArenaConfig) {.growable = true, .zeroing = ARENA_ZERO_NEVER});
+        start = Bench_now();
+        struct ArenaVector vector = ArenaVector_of(arena, int);
+
+        for (size_t i = 0u; i < VECTOR_OPERATIONS; i++) {
+            *(int *) ArenaVector_push(&vector) = (int) i;
+        }
+
+        Arena_drop(arena);
+        Bench_report("containers", "vector-push", "arena", VECTOR_OPERATIONS, Bench_now() - start);
+    }
+    {
+        start = Bench_now();
+        int *data = NULL;
+        size_t capacity = 0u;
+
+        for (size_t i = 0u; i < VECTOR_OPERATIONS; i++) {
+            if (i == capacity) {
+                capacity = 0u == capacity ? 8u : capacity * 2u;
+                data = realloc(data, capacity * sizeof(*data));
+            }
+
+            data[i] = (int) i;
+        }
+
+        Bench_consume(data);
+        free(data);
+        Bench_report("containers", "vector-push", "malloc", VECTOR_OPERATIONS, Bench_now() - start);
+    }
+
+    // string builder
+    {
+        struct Arena *const arena = Arena_withConfig(&(struct ArenaConfig) {.growable = true, .zeroing = ARENA_ZERO_NEVER});
+        start = Bench_now();
+        struct ArenaString string = ArenaString_new(arena);
+
+        for (size_t i = 0u; i < STRING_OPERATIONS; i++) {
+            ArenaString_append(&string, "token ", 6u);
+        }
+
+        Bench_consume(ArenaString_get(&string));
+        Arena_drop(arena);
+        Bench_report("containers", "string-append", "arena", STRING_OPERATIONS, Bench_now() - start);
+    }
+    {
+        start = Bench_now();
+        char *data = NULL;
+        size_t length = 0u, capacity = 0u;
+
+        for (size_t i = 0u; i < STRING_OPERATIONS; i++) {
+            if (length + 7u > capacity) {
+                capacity = capacity < 16u ? 16u : capacity * 2u;
+                data = realloc(data, capacity);
+            }
+
+            memcpy(&data[length], "token ", 6u);
+            length += 6u;
+            data[length] = '\0';
+        }
+
+        Bench_consume(data);
+        free(data);
+        Bench_report("containers", "string-append", "malloc", STRING_OPERATIONS, Bench_now() - start);
+    }
+
+    // hash map
+    {
+        struct Arena *const arena = Arena_withConfig(&(struct ArenaConfig) {.growable = true, .zeroing = ARENA_ZERO_NEVER});
+        start = Bench_now();
+        struct ArenaMap map = ArenaMap_new(arena);
+
+        for (size_t i = 0u; i < MAP_OPERATIONS; i++) {
+            ArenaMap_put(&map, key, (size_t) snprintf(key, sizeof(key), "key-%zu", i), (void *) i);
+        }
+
+        for (size_t i = 0u; i < MAP_OPERATIONS; i++) {
+            Bench_consume(ArenaMap_get(&map, key, (size_t) snprintf(key, sizeof(key), "key-%zu", i)));
+        }
+
+        Arena_drop(arena);
+        Bench_report("containers", "map-put-get", "arena", 2u * MAP_OPERATIONS, Bench_now() - start);
+    }
+    {
+        start = Bench_now();
+        struct HeapMap map = {0};
+
+        for (size_t i = 0u; i < MAP_OPERATIONS; i++) {
+            HeapMap_put(&map, key, (size_t) snprintf(key, sizeof(key), "key-%zu", i), (void *) i);
+        }
+
+        for (size_t i = 0u; i < MAP_OPERATIONS; i++) {
+            Bench_consume(HeapMap_get(&map, key, (size_t) snprintf(key, sizeof(key), "key-%zu", i)));
+        }
+
+        HeapMap_drop(&map);
+        Bench_report("containers", "map-put-get", "malloc", 2u * MAP_OPERATIONS, Bench_now() - start);
+    }
+
+    return 0;
+}
+
+struct HeapMapEntry *HeapMap_probe(struct HeapMapEntry *const entries, const size_t capacity, const uint64_t hash,
+                                   const void *const key, const size_t keySize) {
+    const size_t mask = capacity - 1u;
+
+    for (size_t i = (size_t) hash & mask;; i = (i + 1u) & mask) {
+        struct HeapMapEntry *const entry = &entries[i];
+
+        if (NULL == entry->key ||
+            (hash == entry->hash && keySize == entry->keySize && 0 == memcmp(key, entry->key, keySize))) {
+            return entry;
+        }
+    }
+}
+
+void HeapMap_put(struct HeapMap *const self, const void *const key, const size_t keySize, void *const value) {
+    if (4u * (self->length + 1u) > 3u * self->capacity) {
+        const size_t capacity = 0u == self->capacity ? 16u : self->capacity * 2u;
+        struct HeapMapEntry *const entries = calloc(capacity, sizeof(*entries));
+
+        for (size_t i = 0u; i < self->capacity; i++) {
+            const struct HeapMapEntry *const entry = &self->entries[i];
+
+            if (NULL != entry->key) {
+                *HeapMap_probe(entries, capacity, entry->hash, entry->key, entry->keySize) = *entry;
+            }
+        }
+
+        free(self->entries);
+        self->entries = entries;
+        self->capacity = capacity;
+    }
+
+    const uint64_t hash = ArenaMap_hash(key, keySize);
+    struct HeapMapEntry *const entry = HeapMap_probe(self->entries, self->capacity, hash, key, keySize);
+
+    if (NULL == entry->key) {
+        entry->hash = hash;
+        entry->key = memcpy(malloc(keySize), key, keySize);
+        entry->keySize = keySize;
+        self->length += 1u;
+    }
+
+    entry->value = value;
+}
+
+void **HeapMap_get(const struct HeapMap *const self, const void *const key, const size_t keySize) {
+    struct HeapMapEntry *const entry = HeapMap_probe(self->entries, self->capacity,
+                                                     ArenaMap_hash(key, keySize), key, keySize);
+    return NULL == entry->key ? NULL : &entry->value;
+}
+
+void HeapMap_drop(struct HeapMap *const self) {
+    for (size_t i = 0u; i < self->capacity; i++) {
+        free(self->entries[i].key);
+    }
+
+    free(self->entries);
+}
+
@@ -0,0 +1,201 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <arena.h>
+#include <frame_arena.h>
+#include "bench.h"
+
+#define SUITE       "frame"
+#define FRAMES      20000u
+#define MESSAGES    256u
+#define DEPTH       3u      // frames the consumer may lag behind the producer
+
+static const size_t sizes[] = {16u, 48u, 200u, 24u, 96u, 64u, 32u, 128u};
+
+// the messages produced during a frame, read by the consumer once the frame is complete
+struct Batch {
+    size_t length;
+    void *messages[MESSAGES];
+};
+
+static struct FrameArena *frames;
+static struct Batch *_Atomic batches[DEPTH + 1u];
+static atomic_size_t consumed;
+
+static void *frameProducer(void *argument);
+
+static void *frameConsumer(void *argument);
+
+static void *mallocProducer(void *argument);
+
+static void *mallocConsumer(void *argument);
+
+static uint64_t run(void *(*producer)(void *), void *(*consumer)(void *));
+
+static void waitConsumer(size_t index);
+
+static void fill(struct Batch *batch, void *(*allocate)(size_t), size_t index);
+
+static size_t checksum(const struct Batch *batch);
+
+static void *frameAllocate(size_t size);
+
+int main() {
+    // a frame lives until the consumer, up to DEPTH frames behind, is done with it
+    frames = FrameArena_new(&(struct ArenaConfig) {
+            .capacity = 64u * 1024u,
+            .growable = true,
+            .zeroing = ARENA_ZERO_NEVER,
+    }, DEPTH + 1u);
+
+    Bench_report(SUITE, "pipeline", "malloc", FRAMES * MESSAGES, run(mallocProducer, mallocConsumer));
+    Bench_report(SUITE, "pipeline", "frames", FRAMES * MESSAGES, run(frameProducer, frameConsumer));
+
+    FrameArena_drop(frames);
+    return 0;
+}
+
+uint64_t run(void *(*const producer)(void *), void *(*const consumer)(void *)) {
+    pthread_t threads[2];
+    atomic_store(&consumed, 0u);
+    const uint64_t start = Bench_now();
+
+    if (0 != pthread_create(&threads[0], NULL, consumer, NULL) ||
+        0 != pthread_create(&threads[1], NULL, producer, NULL)) {
+        abort();
+    }
+
+    pthread_join(threads[1], NULL);
+    pthread_join(threads[0], NULL);
+    return Bench_now() - start;
+}
+
+void waitConsumer(const size_t index) {
+    while (index >= atomic_load_explicit(&consumed, memory_order_acquire) + DEPTH) {
+        sched_yield();
+    }
+}
+
+void fill(struct Batch *const batch, void *(*const allocate)(size_t), const size_t index) {
+    batch->length = MESSAGES;
+
+    for (size_t i = 0u; i < MESSAGES; i++) {
+        const size_t size = sizes[(index + i) % (sizeof(sizes) / sizeof(sizes[0]))];
+        batch->messages[i] = allocate(size);
+        memset(batch->messages[i], (int) i, size);
+    }
+}
+
+size_t checksum(const struct Batch *const batch) {
+    size_t sum = 0u;
+
+    for (size_t i = 0u; i < batch->length; i++) {
+        sum += *(const unsigned char *) batch->messages[i];
+    }
+
+    return sum;
+}
+
+void *frameAllocate(const size_t size) {
+    return FrameArena_allocate(frames, 8u, size);
+}
+
+void *frameProducer(void *const argument) {
+    (void) argument;
+
+    for (size_t i = 0u; i < FRAMES; i++) {
+        waitConsumer(i);
+        struct Batch *const batch = Arena_make(FrameArena_arena(frames), struct Batch);
+        fill(batch, frameAllocate, i);
+        // published to the consumer by FrameArena_advance
+        atomic_store_explicit(&batches[i % (DEPTH + 1u)], batch, memory_order_relaxed);
+
+        while (!FrameArena_advance(frames)) {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+void *frameConsumer(void *const argument) {
+    (void) argument;
+    const uint64_t first = FrameArena_frame(frames);
+
+    for (size_t i = 0u; i < FRAMES; i++) {
+        while (!FrameArena_acquire(frames, first + i)) {
+            sched_yield();
+        }
+
+        const struct Batch *const batch = atomic_load_explicit(&batches[i % (DEPTH + 1u)], memory_order_relaxed);
+        Bench_consume((const void *) (uintptr_t) checksum(batch));
+        FrameArena_release(frames, first + i);
+        atomic_store_explicit(&consumed, i + 1u, memory_order_release);
+    }
+
+    return NULL;
+}
+
+void *mallocProducer(void *const argument) {
+    (void) argument;
+
+    for (size_t i = 0u; i < FRAMES; i++) {
+        waitConsumer(i);
+        struct Batch *const batch = malloc(sizeof(*batch));
+        fill(batch, malloc, i);
+        atomic_store_explicit(&batches[i % (DEPTH + 1u)], batch, memory_order_release);
+    }
+
+    return NULL;
+}
+
+void *mallocConsumer(void *const argument) {
+    (void) argument;
+
+    for (size_t i = 0u; i < FRAMES; i++) {
+        struct Batch *batch;
+
+        while (NULL == (batch = atomic_exchange_explicit(&batches[i % (DEPTH + 1u)], NULL, memory_order_acquire))) {
+            sched_yield();
+        }
+
+        Bench_consume((const void *) (uintptr_t) checksum(batch));
+
+        for (size_t i = 0u; i < batch->length; i++) {
+            free(batch->messages[i]);
+        }
+
+        free(batch);
+        atomic_store_explicit(&consumed, i + 1u, memory_order_release);
+    }
+
+    return NULL;
+}
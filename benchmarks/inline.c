@@ -0,0 +1,96 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdalign.h>
+#include <arena.h>
+#include "bench.h"
+
+#define SUITE       "inline"
+#define OPERATIONS  10000000u
+#define BATCH       4096u
+
+struct Node {
+    struct Node *next;
+    int value;
+};
+
+static volatile size_t dynamicSize = 24u;
+
+int main() {
+    struct Arena *const arena = Arena_withConfig(&(struct ArenaConfig) {
+            .capacity = BATCH * 32u,
+            .zeroing = ARENA_ZERO_NEVER,
+    });
+    const size_t size = dynamicSize;
+    uint64_t start;
+
+    start = Bench_now();
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        Bench_consume(Arena_allocate(arena, 8u, size));
+
+        if (BATCH - 1u == i % BATCH) {
+            Arena_clear(arena);
+        }
+    }
+    Bench_report(SUITE, "dynamic-size", "call", OPERATIONS, Bench_now() - start);
+    Arena_clear(arena);
+
+    start = Bench_now();
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        Bench_consume(Arena_allocateInline(arena, 8u, size));
+
+        if (BATCH - 1u == i % BATCH) {
+            Arena_clear(arena);
+        }
+    }
+    Bench_report(SUITE, "dynamic-size", "inline", OPERATIONS, Bench_now() - start);
+    Arena_clear(arena);
+
+    start = Bench_now();
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        Bench_consume(Arena_allocate(arena, alignof(struct Node), sizeof(struct Node)));
+
+        if (BATCH - 1u == i % BATCH) {
+            Arena_clear(arena);
+        }
+    }
+    Bench_report(SUITE, "constant-size", "call", OPERATIONS, Bench_now() - start);
+    Arena_clear(arena);
+
+    start = Bench_now();
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        Bench_consume(Arena_make(arena, struct Node));
+
+        if (BATCH - 1u == i % BATCH) {
+            Arena_clear(arena);
+        }
+    }
+    Bench_report(SUITE, "constant-size", "inline", OPERATIONS, Bench_now() - start);
+
+    Arena_drop(arena);
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arena.h>
+#include <containers.h>
+#include "bench.h"
+
+#define SUITE       "intern"
+#define TOKENS      2000000u
+#define VOCABULARY  50000u
+
+static const char *const keywords[] = {
+        "if", "else", "for", "while", "return", "int", "char", "const", "struct", "static",
+        "(", ")", "{", "}", ";", ",", "=", "==", "+", "->",
+};
+
+#define countOf(array)  (sizeof(array) / sizeof((array)[0]))
+
+struct Token {
+    const char *text;
+    size_t length;
+};
+
+static struct Token *tokens;
+
+static struct Arena *newArena(void);
+
+static void tokenize(char *buffer);
+
+static uint64_t cloneAll(size_t *consumed);
+
+static uint64_t mapAll(size_t *consumed);
+
+static uint64_t internAll(size_t *consumed);
+
+int main() {
+    // identifiers and literals take the text of their tokens from here, as a lexer would from the source
+    char *const buffer = malloc(TOKENS * 24u);
+    size_t consumed;
+    tokens = malloc(TOKENS * sizeof(tokens[0]));
+    tokenize(buffer);
+
+    Bench_report(SUITE, "tokens", "clone", TOKENS, cloneAll(&consumed));
+    fprintf(stderr, "%s: clone consumed %zu bytes\n", SUITE, consumed);
+
+    Bench_report(SUITE, "tokens", "map", TOKENS, mapAll(&consumed));
+    fprintf(stderr, "%s: map consumed %zu bytes\n", SUITE, consumed);
+
+    Bench_report(SUITE, "tokens", "intern", TOKENS, internAll(&consumed));
+    fprintf(stderr, "%s: intern consumed %zu bytes\n", SUITE, consumed);
+
+    free(tokens);
+    free(buffer);
+    return 0;
+}
+
+struct Arena *newArena(void) {
+    return Arena_withConfig(&(struct ArenaConfig) {
+            .capacity = 64u * 1024u,
+            .maxBlockCapacity = 16u * 1024u * 1024u,
+            .growable = true,
+            .zeroing = ARENA_ZERO_NEVER,
+    });
+}
+
+void tokenize(char *buffer) {
+    uint64_t state = 88172645463325252u;
+
+    for (size_t i = 0u; i < TOKENS; i++) {
+        state ^= state << 13u;
+        state ^= state >> 7u;
+        state ^= state << 17u;
+        struct Token *const token = &tokens[i];
+
+        if (state % 2u == 0u) {
+            // about half of the tokens are keywords and punctuation
+            token->text = keywords[(state >> 8u) % countOf(keywords)];
+            token->length = strlen(token->text);
+        } else {
+            // identifiers roughly follow a Zipf distribution: few of them are very frequent
+            const uint64_t rank = ((state >> 8u) % VOCABULARY) * ((state >> 32u) % VOCABULARY) / VOCABULARY;
+            token->text = buffer;
+            token->length = (size_t) sprintf(buffer, "identifier_%llu", (unsigned long long) rank);
+            buffer += token->length + 1u;
+        }
+    }
+}
+
+uint64_t cloneAll(size_t *const consumed) {
+    struct Arena *const arena = newArena();
+    const uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < TOKENS; i++) {
+        Bench_consume(Arena_clone(arena, tokens[i].text, 1u, tokens[i].length));
+    }
+
+    const uint64_t elapsed = Bench_now() - start;
+    *consumed = Arena_size(arena);
+    Arena_drop(arena);
+    return elapsed;
+}
+
+uint64_t mapAll(size_t *const consumed) {
+    struct Arena *const arena = newArena();
+    struct ArenaMap map = ArenaMap_new(arena);
+    const uint64_t start = Bench_now();
+
+    // the closest thing available before: the keys of a map dedupe the strings
+    for (size_t i = 0u; i < TOKENS; i++) {
+        void **const value = ArenaMap_get(&map, tokens[i].text, tokens[i].length);
+
+        if (NULL == value) {
+            ArenaMap_put(&map, tokens[i].text, tokens[i].length, NULL);
+        }
+
+        Bench_consume(value);
+    }
+
+    const uint64_t elapsed = Bench_now() - start;
+    *consumed = Arena_size(arena);
+    Arena_drop(arena);
+    return elapsed;
+}
+
+uint64_t internAll(size_t *const consumed) {
+    struct Arena *const arena = newArena();
+    struct ArenaInterner interner = ArenaInterner_new(arena);
+    const uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < TOKENS; i++) {
+        Bench_consume(ArenaInterner_intern(&interner, tokens[i].text, tokens[i].length));
+    }
+
+    const uint64_t elapsed = Bench_now() - start;
+    *consumed = Arena_size(arena);
+    Arena_drop(arena);
+    return elapsed;
+}
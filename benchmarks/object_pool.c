@@ -0,0 +1,183 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <arena.h>
+#include <object_pool.h>
+#include "bench.h"
+
+#define SUITE       "object_pool"
+#define LIVE        4096u
+#define OPERATIONS  2000000u
+
+struct Node {
+    struct Node *left;
+    struct Node *right;
+    size_t key;
+    double payload[3];
+};
+
+static void *slots[LIVE];
+
+// a cheap xorshift so that every backend replays the same churn sequence
+static inline size_t next(size_t *const state) {
+    size_t x = *state;
+    x ^= x << 13u;
+    x ^= x >> 7u;
+    x ^= x << 17u;
+    return *state = x;
+}
+
+static struct Arena *newArena(void);
+
+static uint64_t runMalloc(void);
+
+static uint64_t runBump(size_t *consumed);
+
+static uint64_t runPool(size_t *consumed);
+
+static uint64_t runSizeClasses(size_t *consumed);
+
+int main() {
+    size_t consumed;
+
+    Bench_report(SUITE, "churn", "malloc", OPERATIONS, runMalloc());
+
+    Bench_report(SUITE, "churn", "bump", OPERATIONS, runBump(&consumed));
+    fprintf(stderr, "%s: bump consumed %zu bytes\n", SUITE, consumed);
+
+    Bench_report(SUITE, "churn", "pool", OPERATIONS, runPool(&consumed));
+    fprintf(stderr, "%s: pool consumed %zu bytes\n", SUITE, consumed);
+
+    Bench_report(SUITE, "churn-mixed", "classes", OPERATIONS, runSizeClasses(&consumed));
+    fprintf(stderr, "%s: size classes consumed %zu bytes\n", SUITE, consumed);
+
+    return 0;
+}
+
+struct Arena *newArena(void) {
+    return Arena_withConfig(&(struct ArenaConfig) {
+            .capacity = 64u * 1024u,
+            .maxBlockCapacity = 16u * 1024u * 1024u,
+            .growable = true,
+            .zeroing = ARENA_ZERO_NEVER,
+    });
+}
+
+uint64_t runMalloc(void) {
+    size_t state = 88172645463325252u;
+    const uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < LIVE; i++) {
+        slots[i] = malloc(sizeof(struct Node));
+    }
+
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        const size_t slot = next(&state) % LIVE;
+        free(slots[slot]);
+        slots[slot] = malloc(sizeof(struct Node));
+        Bench_consume(slots[slot]);
+    }
+
+    for (size_t i = 0u; i < LIVE; i++) {
+        free(slots[i]);
+    }
+
+    return Bench_now() - start;
+}
+
+uint64_t runBump(size_t *const consumed) {
+    size_t state = 88172645463325252u;
+    struct Arena *const arena = newArena();
+    const uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < LIVE; i++) {
+        slots[i] = Arena_make(arena, struct Node);
+    }
+
+    // a bump allocator cannot reuse dead objects: memory grows with every replacement
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        const size_t slot = next(&state) % LIVE;
+        slots[slot] = Arena_make(arena, struct Node);
+        Bench_consume(slots[slot]);
+    }
+
+    const uint64_t elapsed = Bench_now() - start;
+    *consumed = Arena_size(arena);
+    Arena_drop(arena);
+    return elapsed;
+}
+
+uint64_t runPool(size_t *const consumed) {
+    size_t state = 88172645463325252u;
+    struct Arena *const arena = newArena();
+    const uint64_t start = Bench_now();
+    struct ObjectPool *const pool = ObjectPool_of(arena, struct Node);
+
+    for (size_t i = 0u; i < LIVE; i++) {
+        slots[i] = ObjectPool_allocate(pool);
+    }
+
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        const size_t slot = next(&state) % LIVE;
+        ObjectPool_release(pool, slots[slot]);
+        slots[slot] = ObjectPool_allocate(pool);
+        Bench_consume(slots[slot]);
+    }
+
+    const uint64_t elapsed = Bench_now() - start;
+    *consumed = Arena_size(arena);
+    Arena_drop(arena);
+    return elapsed;
+}
+
+uint64_t runSizeClasses(size_t *const consumed) {
+    static size_t sizes[LIVE];
+    size_t state = 88172645463325252u;
+    struct Arena *const arena = newArena();
+    const uint64_t start = Bench_now();
+    struct SizeClassPool *const pool = SizeClassPool_new(arena);
+
+    for (size_t i = 0u; i < LIVE; i++) {
+        sizes[i] = 16u + next(&state) % 240u;
+        slots[i] = SizeClassPool_allocate(pool, sizes[i]);
+    }
+
+    for (size_t i = 0u; i < OPERATIONS; i++) {
+        const size_t slot = next(&state) % LIVE;
+        SizeClassPool_release(pool, slots[slot], sizes[slot]);
+        sizes[slot] = 16u + next(&state) % 240u;
+        slots[slot] = SizeClassPool_allocate(pool, sizes[slot]);
+        Bench_consume(slots[slot]);
+    }
+
+    const uint64_t elapsed = Bench_now() - start;
+    *consumed = Arena_size(arena);
+    Arena_drop(arena);
+    return elapsed;
+}
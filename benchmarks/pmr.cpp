@@ -0,0 +1,89 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+#include <arena.hpp>
+#include "bench.h"
+
+#define SUITE       "pmr"
+#define OPERATIONS  200000u
+
+static void vector(const char *backend, std::pmr::memory_resource *resource);
+
+static void unorderedMap(const char *backend, std::pmr::memory_resource *resource);
+
+int main() {
+    struct ArenaConfig config{};
+    config.capacity = 1024u * 1024u;
+    config.maxBlockCapacity = 16u * 1024u * 1024u;
+    config.growable = true;
+    config.zeroing = ARENA_ZERO_NEVER;
+    struct Arena *const arena = Arena_withConfig(&config);
+    arena::Resource resource(arena);
+
+    vector("arena", &resource);
+    vector("default", std::pmr::get_default_resource());
+    Arena_clear(arena);
+    unorderedMap("arena", &resource);
+    unorderedMap("default", std::pmr::get_default_resource());
+
+    Arena_drop(arena);
+    return 0;
+}
+
+void vector(const char *const backend, std::pmr::memory_resource *const resource) {
+    const uint64_t start = Bench_now();
+
+    for (std::size_t round = 0u; round < 16u; round++) {
+        std::pmr::vector<int> values(resource);
+
+        for (std::size_t i = 0u; i < OPERATIONS / 16u; i++) {
+            values.push_back(static_cast<int>(i));
+        }
+
+        Bench_consume(values.data());
+    }
+
+    Bench_report(SUITE, "vector-push", backend, OPERATIONS, Bench_now() - start);
+}
+
+void unorderedMap(const char *const backend, std::pmr::memory_resource *const resource) {
+    const uint64_t start = Bench_now();
+    std::pmr::unordered_map<std::size_t, std::size_t> values(resource);
+
+    for (std::size_t i = 0u; i < OPERATIONS; i++) {
+        values.emplace(i, i);
+    }
+
+    for (std::size_t i = 0u; i < OPERATIONS; i++) {
+        Bench_consume(&values.at(i));
+    }
+
+    Bench_report(SUITE, "unordered-map", backend, 2u * OPERATIONS, Bench_now() - start);
+}
@@ -0,0 +1,114 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <arena.h>
+#include <arena_pool.h>
+#include "bench.h"
+
+#define SUITE       "pool"
+#define REQUESTS    50000u
+#define CAPACITY    (256u * 1024u)
+#define MAX_THREADS 64u
+
+static const size_t sizes[] = {16u, 48u, 200u, 1024u, 24u, 96u};
+
+static struct ArenaPool *pool;
+
+static void request(struct Arena *arena);
+
+static void *createDropWorker(void *argument);
+
+static void *poolWorker(void *argument);
+
+static uint64_t run(void *(*worker)(void *), size_t threads);
+
+int main() {
+    const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    const size_t maxThreads = processors < 4 ? 4u : processors > (long) MAX_THREADS ? MAX_THREADS : (size_t) processors;
+    pool = ArenaPool_new(&(struct ArenaConfig) {.capacity = CAPACITY}, maxThreads);
+
+    for (size_t threads = 1u; threads <= maxThreads; threads *= 2u) {
+        char workload[32];
+        snprintf(workload, sizeof(workload), "threads-%zu", threads);
+        Bench_report(SUITE, workload, "create", threads * REQUESTS, run(createDropWorker, threads));
+        Bench_report(SUITE, workload, "pool", threads * REQUESTS, run(poolWorker, threads));
+    }
+
+    ArenaPool_drop(pool);
+    return 0;
+}
+
+void request(struct Arena *const arena) {
+    for (size_t i = 0u; i < 64u; i++) {
+        Bench_consume(Arena_allocate(arena, 8u, sizes[i % (sizeof(sizes) / sizeof(sizes[0]))]));
+    }
+}
+
+void *createDropWorker(void *const argument) {
+    (void) argument;
+
+    for (size_t i = 0u; i < REQUESTS; i++) {
+        struct Arena *const arena = Arena_withCapacity(CAPACITY);
+        request(arena);
+        Arena_drop(arena);
+    }
+
+    return NULL;
+}
+
+void *poolWorker(void *const argument) {
+    (void) argument;
+
+    for (size_t i = 0u; i < REQUESTS; i++) {
+        struct Arena *const arena = ArenaPool_acquire(pool);
+        request(arena);
+        ArenaPool_release(pool, arena);
+    }
+
+    return NULL;
+}
+
+uint64_t run(void *(*const worker)(void *), const size_t threads) {
+    pthread_t handles[MAX_THREADS];
+    const uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < threads; i++) {
+        if (0 != pthread_create(&handles[i], NULL, worker, NULL)) {
+            abort();
+        }
+    }
+
+    for (size_t i = 0u; i < threads; i++) {
+        pthread_join(handles[i], NULL);
+    }
+
+    return Bench_now() - start;
+}
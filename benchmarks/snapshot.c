@@ -0,0 +1,168 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <arena.h>
+#include <containers.h>
+#include "bench.h"
+
+#define SUITE       "snapshot"
+#define KEYS        200000u
+#define STARTUPS    10u
+
+// a read-only lookup table linked by relative pointers so that it can be reloaded anywhere
+struct Entry {
+    struct ArenaRelative key;
+    uint64_t value;
+};
+
+struct Table {
+    size_t capacity;
+    struct ArenaRelative entries;
+};
+
+static char path[64];
+
+static const struct Table *build(struct Arena *arena);
+
+static uint64_t lookupAll(const struct Table *table);
+
+static uint64_t rebuild(bool touch);
+
+static uint64_t reload(bool touch);
+
+int main() {
+    snprintf(path, sizeof(path), "/tmp/bench_snapshot.%ld", (long) getpid());
+    struct Arena *const arena = Arena_withConfig(&(struct ArenaConfig) {.backend = ARENA_BACKEND_VIRTUAL});
+
+    if (!Arena_save(arena, build(arena), path)) {
+        perror(path);
+        return 1;
+    }
+
+    fprintf(stderr, "%s: %zu bytes saved\n", SUITE, Arena_size(arena));
+    Arena_drop(arena);
+
+    Bench_report(SUITE, "startup", "rebuild", STARTUPS, rebuild(false));
+    Bench_report(SUITE, "startup", "load", STARTUPS, reload(false));
+    Bench_report(SUITE, "startup+lookups", "rebuild", STARTUPS, rebuild(true));
+    Bench_report(SUITE, "startup+lookups", "load", STARTUPS, reload(true));
+
+    remove(path);
+    return 0;
+}
+
+const struct Table *build(struct Arena *const arena) {
+    struct Table *const table = Arena_make(arena, struct Table);
+    table->capacity = 1u;
+
+    while (table->capacity < KEYS * 2u) {
+        table->capacity *= 2u;
+    }
+
+    struct Entry *const entries = Arena_makeArray(arena, struct Entry, table->capacity);
+    memset(entries, 0u, table->capacity * sizeof(*entries));
+    ArenaRelative_set(&table->entries, entries);
+
+    for (size_t i = 0u; i < KEYS; i++) {
+        char key[32];
+        const size_t length = (size_t) snprintf(key, sizeof(key), "key-%zu", i) + 1u;
+        size_t slot = ArenaMap_hash(key, length) & (table->capacity - 1u);
+
+        while (NULL != ArenaRelative_get(&entries[slot].key)) {
+            slot = (slot + 1u) & (table->capacity - 1u);
+        }
+
+        ArenaRelative_set(&entries[slot].key, Arena_clone(arena, key, 1u, length));
+        entries[slot].value = i;
+    }
+
+    return table;
+}
+
+uint64_t lookupAll(const struct Table *const table) {
+    const struct Entry *const entries = ArenaRelative_get(&table->entries);
+    uint64_t sum = 0u;
+
+    for (size_t i = 0u; i < KEYS; i++) {
+        char key[32];
+        const size_t length = (size_t) snprintf(key, sizeof(key), "key-%zu", i) + 1u;
+        size_t slot = ArenaMap_hash(key, length) & (table->capacity - 1u);
+
+        while (0 != strcmp(key, ArenaRelative_get(&entries[slot].key))) {
+            slot = (slot + 1u) & (table->capacity - 1u);
+        }
+
+        sum += entries[slot].value;
+    }
+
+    return sum;
+}
+
+uint64_t rebuild(const bool touch) {
+    const uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < STARTUPS; i++) {
+        struct Arena *const arena = Arena_withConfig(&(struct ArenaConfig) {.backend = ARENA_BACKEND_VIRTUAL});
+        const struct Table *const table = build(arena);
+        Bench_consume(table);
+
+        if (touch) {
+            Bench_consume((const void *) (uintptr_t) lookupAll(table));
+        }
+
+        Arena_drop(arena);
+    }
+
+    return Bench_now() - start;
+}
+
+uint64_t reload(const bool touch) {
+    const uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < STARTUPS; i++) {
+        const void *root;
+        struct Arena *const arena = Arena_load(path, &root);
+
+        if (NULL == arena) {
+            perror(path);
+            exit(1);
+        }
+
+        Bench_consume(root);
+
+        if (touch) {
+            Bench_consume((const void *) (uintptr_t) lookupAll(root));
+        }
+
+        Arena_drop(arena);
+    }
+
+    return Bench_now() - start;
+}
@@ -0,0 +1,154 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdalign.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <arena.h>
+#include <concurrent_arena.h>
+#include <thread_arena.h>
+#include "bench.h"
+
+#define SUITE           "thread"
+#define OPERATIONS      1000000u
+#define BATCH           4096u       // allocations between two clears, as a request handler would do
+#define ALLOCATION_SIZE 24u
+#define BLOCK_CAPACITY  (64u * 1024u)
+#define MAX_THREADS     64u
+
+static struct ConcurrentArena *concurrentArena;
+static struct ThreadArena *threadArena;
+
+static void *mallocWorker(void *argument);
+
+static void *concurrentWorker(void *argument);
+
+static void *localWorker(void *argument);
+
+static uint64_t run(void *(*worker)(void *), size_t threads);
+
+int main() {
+    const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    const size_t maxThreads = processors < 4 ? 4u : processors > (long) MAX_THREADS ? MAX_THREADS : (size_t) processors;
+    struct ArenaReservoir *const reservoir = ArenaReservoir_new(BLOCK_CAPACITY, 2u * maxThreads);
+    concurrentArena = ConcurrentArena_withCapacity(maxThreads * BATCH * (ALLOCATION_SIZE + alignof(max_align_t)));
+    threadArena = ThreadArena_new(&(struct ArenaConfig) {
+            .capacity = ARENA_MIN_CAPACITY,
+            .growable = true,
+            .zeroing = ARENA_ZERO_NEVER,
+            .reservoir = reservoir,
+    });
+
+    for (size_t threads = 1u; threads <= maxThreads; threads *= 2u) {
+        char workload[32];
+        snprintf(workload, sizeof(workload), "threads-%zu", threads);
+        Bench_report(SUITE, workload, "malloc", threads * OPERATIONS, run(mallocWorker, threads));
+        Bench_report(SUITE, workload, "atomic", threads * OPERATIONS, run(concurrentWorker, threads));
+        Bench_report(SUITE, workload, "local", threads * OPERATIONS, run(localWorker, threads));
+    }
+
+    ThreadArena_drop(threadArena);
+    ConcurrentArena_drop(concurrentArena);
+    ArenaReservoir_drop(reservoir);
+    return 0;
+}
+
+void *mallocWorker(void *const argument) {
+    (void) argument;
+    void *pointers[BATCH];
+
+    for (size_t i = 0u; i < OPERATIONS; i += BATCH) {
+        for (size_t j = 0u; j < BATCH; j++) {
+            Bench_consume(pointers[j] = malloc(ALLOCATION_SIZE));
+        }
+
+        for (size_t j = 0u; j < BATCH; j++) {
+            free(pointers[j]);
+        }
+    }
+
+    return NULL;
+}
+
+void *concurrentWorker(void *const argument) {
+    pthread_barrier_t *const barrier = argument;
+
+    // the shared offset can only be reset once every thread is done with its batch
+    for (size_t i = 0u; i < OPERATIONS; i += BATCH) {
+        for (size_t j = 0u; j < BATCH; j++) {
+            Bench_consume(ConcurrentArena_allocate(concurrentArena, alignof(max_align_t), ALLOCATION_SIZE));
+        }
+
+        if (PTHREAD_BARRIER_SERIAL_THREAD == pthread_barrier_wait(barrier)) {
+            ConcurrentArena_clear(concurrentArena);
+        }
+
+        pthread_barrier_wait(barrier);
+    }
+
+    return NULL;
+}
+
+void *localWorker(void *const argument) {
+    (void) argument;
+    struct Arena *const arena = ThreadArena_get(threadArena);
+
+    for (size_t i = 0u; i < OPERATIONS; i += BATCH) {
+        for (size_t j = 0u; j < BATCH; j++) {
+            Bench_consume(Arena_allocate(arena, alignof(max_align_t), ALLOCATION_SIZE));
+        }
+
+        Arena_clear(arena);
+    }
+
+    return NULL;
+}
+
+uint64_t run(void *(*const worker)(void *), const size_t threads) {
+    assert(threads <= MAX_THREADS);
+    pthread_t handles[MAX_THREADS];
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, (unsigned) threads);
+    const uint64_t start = Bench_now();
+
+    for (size_t i = 0u; i < threads; i++) {
+        if (0 != pthread_create(&handles[i], NULL, worker, &barrier)) {
+            abort();
+        }
+    }
+
+    for (size_t i = 0u; i < threads; i++) {
+        pthread_join(handles[i], NULL);
+    }
+
+    const uint64_t elapsed = Bench_now() - start;
+    pthread_barrier_destroy(&barrier);
+    return elapsed;
+}
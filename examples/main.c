@@ -38,10 +38,13 @@ int main() {
     const char string[] = "Hello World!\n";
 
     printArena(arena);
-    const long double *const a = Arena_clone(arena, &number, alignof(number), sizeof(number));
-    const char *const b = Arena_clone(arena, string, alignof(string), sizeof(string));
-    const int *const c = Arena_allocate(arena, alignof(*c), sizeof(*c));
+    const long double *const a = Arena_cloneTraced(arena, &number, alignof(number), sizeof(number));
+    const char *const b = Arena_cloneTraced(arena, string, alignof(string), sizeof(string));
+    const int *const c = Arena_allocateTraced(arena, alignof(*c), sizeof(*c));
     printArena(arena);
+#if ARENA_PROFILE_SUPPORT
+    Arena_dumpSites(arena, stdout, 8u);
+#endif
 
     printf("%sThe number of the day is: %LF\nUninitialized value: %d\n", b, *a, *c);
 
@@ -53,4 +56,11 @@ static void printArena(const struct Arena *const self) {
     assert(NULL != self);
     printf("Arena(available=%zu, capacity=%zu, size=%zu)\n",
            Arena_available(self), Arena_capacity(self), Arena_size(self));
+#if ARENA_STATS_SUPPORT
+    const struct ArenaStats stats = Arena_stats(self);
+    printf("ArenaStats(allocations=%zu, requested=%zu, consumed=%zu, padding=%zu, highWaterMark=%zu, "
+           "largeAllocations=%zu, largeBytes=%zu)\n",
+           stats.allocations, stats.requestedBytes, stats.consumedBytes, stats.paddingBytes, stats.highWaterMark,
+           stats.largeAllocations, stats.largeBytes);
+#endif
 }
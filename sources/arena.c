@@ -25,117 +25,898 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+// MAP_ANONYMOUS, MAP_NORESERVE and madvise are not part of POSIX, they must be requested under strict ISO C
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
 #include <panic/panic.h>
 #include <stdalign.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <memory.h>
 #include <assert.h>
 #include "arena.h"
+#include "arena_internal.h"
 
-// Taken from Bit Twiddling Hacks: http://graphics.stanford.edu/~seander/bithacks.html#DetermineIfPowerOf2
-#define __isPowerOfTwo(n)   (n && !(n & (n - 1u)))
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 static_assert(ARENA_DEFAULT_CAPACITY >= ARENA_MIN_CAPACITY, "ARENA_DEFAULT_CAPACITY must be >= ARENA_MIN_CAPACITY");
 static_assert(__isPowerOfTwo(ARENA_DEFAULT_CAPACITY), "ARENA_DEFAULT_CAPACITY must be a power of 2");
 static_assert(__isPowerOfTwo(ARENA_MIN_CAPACITY), "ARENA_MIN_CAPACITY must be a power of 2");
+static_assert(__isPowerOfTwo(ARENA_MAX_ALIGNMENT), "ARENA_MAX_ALIGNMENT must be a power of 2");
+static_assert(ARENA_MAX_ALIGNMENT >= alignof(max_align_t), "ARENA_MAX_ALIGNMENT must be >= alignof(max_align_t)");
+static_assert(__isPowerOfTwo(ARENA_COMMIT_GRANULARITY), "ARENA_COMMIT_GRANULARITY must be a power of 2");
+static_assert(ARENA_COMMIT_GRANULARITY >= ARENA_MAX_ALIGNMENT, "ARENA_COMMIT_GRANULARITY must be >= ARENA_MAX_ALIGNMENT");
+static_assert(ARENA_STATS_BUCKETS > 0u, "ARENA_STATS_BUCKETS must be > 0");
+static_assert(ARENA_ADAPTIVE_WINDOW > 0u, "ARENA_ADAPTIVE_WINDOW must be > 0");
 static_assert(sizeof(char) == 1u, "Unexpected char size");
 
-#define maxAlign    alignof(max_align_t)
-
-static inline __attribute__((__warn_unused_result__))
-size_t max(const size_t a, const size_t b) {
-    return a > b ? a : b;
-}
+#define hugePageSize    ((size_t) 2097152u)
 
-static inline __attribute__((__warn_unused_result__))
-bool isPowerOf2(const size_t n) {
-    return __isPowerOfTwo(n);
-}
+#define maxAlign    alignof(max_align_t)
+#define maxAlignment ((size_t) ARENA_MAX_ALIGNMENT)
 
 static inline __attribute__((__warn_unused_result__, __nonnull__(1)))
 bool isAligned(const void *const memory, const size_t alignment) {
     assert(NULL != memory);
-    assert(alignment <= maxAlign);
+    assert(alignment <= maxAlignment);
     assert(isPowerOf2(alignment));
     return 0u == (((uintptr_t) memory) & (((uintptr_t) alignment) - 1u));
 }
 
 static inline __attribute__((__warn_unused_result__))
 void *align(void *memory, const size_t alignment) {
-    assert(alignment <= maxAlign);
+    assert(alignment <= maxAlignment);
     assert(isPowerOf2(alignment));
     memory = (void *) ((((uintptr_t) memory) + alignment - 1u) & ~(((uintptr_t) alignment) - 1u));
     assert(isAligned(memory, alignment));
     return memory;
 }
 
+static inline __attribute__((__warn_unused_result__))
+size_t roundUpPowerOf2(const size_t n) {
+    assert(n > 1u);
+    return n > SIZE_MAX / 2u + 1u ? n : (size_t) 1u << (64u - (unsigned) __builtin_clzll((unsigned long long) n - 1u));
+}
+
+struct Block {
+    struct Block *next;
+    size_t capacity;
+    char *memory;               // aligned to the base alignment of the arena, it follows the header
+};
+
 struct Arena {
     alignas(max_align_t)
+    struct ArenaCursor cursor;  // must be the first member, it is accessed by Arena_allocateInline
+    struct Block *head;
+    struct Block *current;
+    struct Block *large;        // dedicated blocks of the requests above the threshold, most recent first
+    struct ArenaReservoir *reservoir;
+    struct Arena *adopted;      // arenas adopted by Arena_adopt, most recent first
+    struct Arena *sibling;      // the next arena adopted by the same arena
+    size_t consumed;            // sum of the capacities of the blocks preceding the current one
+    size_t capacity;            // sum of the capacities of all the blocks
+    size_t marks;               // depth of the most recent savepoint still valid
+    size_t maxBlockCapacity;
+    size_t committed;           // committed bytes of the first block of virtual arenas
+    size_t granularity;         // commit granularity of virtual arenas
+    size_t alignment;           // base alignment of the memory of the blocks
+    size_t peak;                // peak size of the current clear cycle of adaptive arenas
+    size_t cycles;              // clear cycles since the last resize of adaptive arenas
+    size_t peaks[ARENA_ADAPTIVE_WINDOW];
+    bool growable;
+    bool decommitOnClear;
+    bool borrowed;              // the first block lives in a buffer provided by the caller
+    bool mapped;                // the first block is a read-only mapping of a snapshot, see Arena_load
+    bool adaptive;
+    bool owned;                 // dropped by ArenaPool, FrameArena or ThreadArena, it cannot be adopted
+    bool handedOver;            // adopted by another arena, see Arena_adopt
+    enum ArenaZeroing zeroing;
+    enum ArenaBackend backend;
+#if ARENA_STATS_SUPPORT
+    struct ArenaStats stats;
+#endif
+#if ARENA_PROFILE_SUPPORT
+    struct SiteTable *sites;    // allocated on the first traced allocation
+#endif
+#if !defined(NDEBUG)
+    struct Savepoints *savepoints;
+#endif
+};
+
+#if !defined(NDEBUG)
+
+struct Savepoints {
+    size_t capacity;
+    size_t sequence;            // the sequence number of the most recent savepoint
+    size_t sequences[];         // the sequence number of the valid savepoint at every depth
+};
+
+#endif
+
+#if ARENA_PROFILE_SUPPORT
+
+struct SiteTable {
+    size_t length;
     size_t capacity;
-    size_t offset;
-    char memory[];
+    struct ArenaSite entries[]; // open addressing by site address, at most half full
 };
 
+#endif
+
+struct ArenaReservoir {
+    alignas(ARENA_CACHE_LINE)
+    size_t capacity;            // capacity of the blocks
+    size_t length;
+    struct Slot slots[];
+};
+
+// the header of the files written by Arena_save, fields are in the native byte order
+struct Snapshot {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;         // snapshotByteOrder as written by the producer
+    uint64_t wordSize;          // sizeof(size_t) of the producer
+    uint64_t alignment;         // base alignment of the saved memory
+    uint64_t phase;             // address of the saved memory modulo ARENA_MAX_ALIGNMENT
+    uint64_t size;              // bytes of saved memory
+    uint64_t root;              // offset of the root in the saved memory
+};
+
+static const char snapshotMagic[8] = "ARENASNP";
+
+#define snapshotByteOrder   0x01020304u
+
+// the saved memory starts at this offset of the file plus its phase: mapped back at a page boundary,
+// every address is congruent to the original one modulo ARENA_MAX_ALIGNMENT, preserving the alignment
+// of over-aligned allocations whose padding depended on the original addresses
+#define snapshotOffset      ((size_t) ARENA_MAX_ALIGNMENT)
+
+static_assert(sizeof(struct Snapshot) <= snapshotOffset, "Unexpected snapshot header size");
+
+// the worst case for buffers aligned to a single byte, see Arena_fromBuffer
+static_assert(sizeof(struct Arena) + sizeof(struct Block) + 2u * alignof(max_align_t) <= ARENA_BUFFER_OVERHEAD,
+              "ARENA_BUFFER_OVERHEAD is too small");
+
+static void Arena_init(struct Arena *self, const struct ArenaConfig *config, size_t alignment)
+__attribute__((__nonnull__(1, 2)));
+
+static struct Arena *Arena_reserve(size_t capacity, size_t alignment, bool hugePages)
+__attribute__((__warn_unused_result__));
+
+static bool Arena_commit(struct Arena *self, size_t alignment, size_t size)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+static size_t Arena_decommit(struct Arena *self)
+__attribute__((__nonnull__(1)));
+
+static void Arena_unreserve(struct Arena *self)
+__attribute__((__nonnull__(1)));
+
+static void Arena_unmap(struct Arena *self)
+__attribute__((__nonnull__(1)));
+
+static void *Arena_allocateLarge(struct Arena *self, size_t alignment, size_t size)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+static void Arena_releaseLarge(struct Arena *self, const struct Block *until)
+__attribute__((__nonnull__(1)));
+
+static void Arena_releaseAdopted(struct Arena *self, const struct Arena *until)
+__attribute__((__nonnull__(1)));
+
+static void Arena_adapt(struct Arena *self)
+__attribute__((__nonnull__(1)));
+
+#if !defined(NDEBUG)
+
+static size_t Arena_pushSavepoint(struct Arena *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+static bool Arena_isValid(const struct Arena *self, struct ArenaMark mark)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+#endif
+
+static void Arena_giveBack(struct Arena *self)
+__attribute__((__nonnull__(1)));
+
+static struct Block *ArenaReservoir_take(struct ArenaReservoir *self, enum ArenaZeroing zeroing)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+static void ArenaReservoir_give(struct ArenaReservoir *self, struct Block *block)
+__attribute__((__nonnull__(1, 2)));
+
+#if ARENA_STATS_SUPPORT
+
+static void Arena_record(struct Arena *self, size_t padding, size_t size)
+__attribute__((__nonnull__(1)));
+
+#endif
+
+#if ARENA_PROFILE_SUPPORT
+
+static void Arena_recordSite(struct Arena *self, const char *site, size_t padding, size_t size)
+__attribute__((__nonnull__(1, 2)));
+
+static struct ArenaSite *Arena_probeSite(struct ArenaSite *sites, size_t capacity, const char *site)
+__attribute__((__warn_unused_result__, __nonnull__(1, 3)));
+
+static struct ArenaSite *Arena_sortedSites(const struct Arena *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+static int compareSites(const void *a, const void *b)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2)));
+
+#endif
+
+static size_t Arena_limitOf(const struct Arena *self, const struct Block *block)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2)));
+
+static void *allocateMemory(size_t size, size_t alignment, enum ArenaZeroing zeroing)
+__attribute__((__warn_unused_result__));
+
+static struct Block *Block_new(size_t capacity, size_t alignment, enum ArenaZeroing zeroing)
+__attribute__((__warn_unused_result__));
+
+static struct Block *Block_map(size_t capacity, size_t alignment)
+__attribute__((__warn_unused_result__));
+
+static void Block_unmap(struct Block *self)
+__attribute__((__nonnull__(1)));
+
+static void *Arena_allocateSlow(struct Arena *self, size_t alignment, size_t size)
+__attribute__((__warn_unused_result__, __nonnull__(1), __noinline__));
+
 struct Arena *Arena_default(void) {
     return Arena_withCapacity(ARENA_DEFAULT_CAPACITY);
 }
 
+void *Arena_allocateLarge(struct Arena *const self, const size_t alignment, const size_t size) {
+    assert(NULL != self);
+    assert(size > self->cursor.threshold);
+    // dedicated mappings read as zero, as every zeroing policy expects from fresh memory
+    struct Block *const block = Block_map(size, max(alignment, self->alignment));
+    block->next = self->large;
+    self->large = block;
+#if ARENA_STATS_SUPPORT
+    self->stats.largeAllocations += 1u;
+    self->stats.largeBytes += size;
+#endif
+    return block->memory;
+}
+
+void Arena_releaseLarge(struct Arena *const self, const struct Block *const until) {
+    assert(NULL != self);
+
+    while (until != self->large) {
+        assert(NULL != self->large);
+        struct Block *const next = self->large->next;
+        Block_unmap(self->large);
+        self->large = next;
+    }
+}
+
+void Arena_releaseAdopted(struct Arena *const self, const struct Arena *const until) {
+    assert(NULL != self);
+
+    while (until != self->adopted) {
+        assert(NULL != self->adopted);
+        struct Arena *const next = self->adopted->sibling;
+        Arena_drop(self->adopted);
+        self->adopted = next;
+    }
+}
+
+#if !defined(NDEBUG)
+
+size_t Arena_pushSavepoint(struct Arena *const self) {
+    assert(NULL != self);
+    struct Savepoints *savepoints = self->savepoints;
+
+    if (NULL == savepoints || self->marks > savepoints->capacity) {
+        const size_t capacity = NULL == savepoints ? 16u : savepoints->capacity * 2u;
+        savepoints = realloc(savepoints, sizeof(*savepoints) + capacity * sizeof(savepoints->sequences[0]));
+
+        if (NULL == savepoints) {
+            panic("Out of memory");
+        }
+
+        savepoints->capacity = capacity;
+        savepoints->sequence = NULL == self->savepoints ? 0u : savepoints->sequence;
+        self->savepoints = savepoints;
+    }
+
+    // sequence numbers are never reused, so stale savepoints do not match those taken later at the same depth
+    savepoints->sequences[self->marks - 1u] = ++savepoints->sequence;
+    return savepoints->sequence;
+}
+
+bool Arena_isValid(const struct Arena *const self, const struct ArenaMark mark) {
+    assert(NULL != self);
+    assert(mark.depth > 0u && mark.depth <= self->marks);
+    return mark.sequence == self->savepoints->sequences[mark.depth - 1u];
+}
+
+#endif
+
+void Arena_adapt(struct Arena *const self) {
+    assert(NULL != self);
+    assert(self->adaptive);
+    const size_t peak = max(self->peak, Arena_size(self));
+    size_t windowPeak = peak;
+    self->peaks[self->cycles % ARENA_ADAPTIVE_WINDOW] = peak;
+    self->cycles += 1u;
+    self->peak = 0u;
+
+    for (size_t i = 0u; i < min(self->cycles, ARENA_ADAPTIVE_WINDOW); i++) {
+        windowPeak = max(windowPeak, self->peaks[i]);
+    }
+
+    // the first block lives with the header and never changes, the others are sized to the window peak
+    const size_t spare = self->capacity - self->head->capacity;
+    const size_t needed = windowPeak > self->head->capacity ? windowPeak - self->head->capacity : 0u;
+    const bool spilled = self->current != self->head && self->current != self->head->next;
+    const bool grow = needed > spare || spilled;
+    const bool shrink = self->cycles >= ARENA_ADAPTIVE_WINDOW && needed < spare / 4u;
+
+    if (!grow && !shrink) {
+        return;
+    }
+
+    // rounding to a power of 2 leaves room for small fluctuations
+    const size_t capacity = 0u == needed ? 0u : roundUpPowerOf2(max(ARENA_MIN_CAPACITY, needed));
+    struct Block *block = self->head->next;
+
+    while (NULL != block) {
+        struct Block *const next = block->next;
+        free(block);
+        block = next;
+    }
+
+    self->head->next = 0u == capacity ? NULL : Block_new(capacity, self->alignment, self->zeroing);
+    self->capacity = self->head->capacity + capacity;
+    self->cycles = 0u;
+}
+
+void Arena_giveBack(struct Arena *const self) {
+    assert(NULL != self);
+    assert(NULL != self->reservoir);
+    assert(self->head == self->current);
+    struct Block *block = self->head->next;
+
+    while (NULL != block) {
+        struct Block *const next = block->next;
+        ArenaReservoir_give(self->reservoir, block);
+        block = next;
+    }
+
+    self->head->next = NULL;
+    self->capacity = self->head->capacity;
+}
+
 struct Arena *Arena_withCapacity(const size_t capacity) {
     assert(capacity > 0u);
-    const size_t actualCapacity = max(ARENA_MIN_CAPACITY, capacity);
-    struct Arena *const self = calloc(1u, sizeof(*self) + actualCapacity);
+    return Arena_withConfig(&(struct ArenaConfig) {.capacity = capacity});
+}
 
-    if (NULL != self) {
-        self->capacity = actualCapacity;
-        return self;
+struct Arena *Arena_withConfig(const struct ArenaConfig *const config) {
+    assert(NULL != config);
+    const size_t alignment = 0u == config->alignment ? maxAlign : max(maxAlign, config->alignment);
+    assert(alignment <= maxAlignment);
+    assert(isPowerOf2(alignment));
+    struct Arena *self;
+
+    if (ARENA_BACKEND_VIRTUAL == config->backend) {
+        self = Arena_reserve(0u == config->capacity ? ARENA_DEFAULT_RESERVE : config->capacity, alignment, config->hugePages);
+    } else {
+        const size_t capacity = max(ARENA_MIN_CAPACITY, 0u == config->capacity ? ARENA_DEFAULT_CAPACITY : config->capacity);
+        const size_t headers = roundUp(sizeof(*self) + sizeof(*self->head), alignment);
+
+        // the first block lives in the same allocation of the arena
+        self = allocateMemory(headers + capacity, alignment, config->zeroing);
+        self->head = (struct Block *) (self + 1);
+        self->head->capacity = capacity;
+        self->head->memory = (char *) self + headers;
+        self->committed = capacity;
+        self->granularity = 0u;
     }
 
-    panic("Out of memory");
+    self->borrowed = false;
+    Arena_init(self, config, alignment);
+    return self;
+}
+
+struct Arena *Arena_fromBuffer(void *const buffer, const size_t size, const struct ArenaConfig *const config) {
+    assert(NULL != buffer);
+    assert(NULL != config);
+    assert(ARENA_BACKEND_HEAP == config->backend);
+    const size_t alignment = 0u == config->alignment ? maxAlign : max(maxAlign, config->alignment);
+    assert(alignment <= maxAlignment);
+    assert(isPowerOf2(alignment));
+    struct Arena *const self = align(buffer, maxAlign);
+    char *const memory = align((char *) (self + 1) + sizeof(*self->head), alignment);
+
+    if (memory > (char *) buffer + size || (size_t) ((char *) buffer + size - memory) < ARENA_MIN_CAPACITY) {
+        panic("Buffer too small");
+    }
+
+    self->head = (struct Block *) (self + 1);
+    self->head->capacity = (char *) buffer + size - memory;
+    self->head->memory = memory;
+    self->committed = self->head->capacity;
+    self->granularity = 0u;
+    self->borrowed = true;
+
+    // the buffer content is unknown
+    if (ARENA_ZERO_ON_CLEAR == config->zeroing) {
+        memset(memory, 0u, self->head->capacity);
+    }
+
+    Arena_init(self, config, alignment);
+    return self;
+}
+
+void Arena_init(struct Arena *const self, const struct ArenaConfig *const config, const size_t alignment) {
+    assert(NULL != self);
+    assert(NULL != config);
+    self->head->next = NULL;
+    self->current = self->head;
+    self->cursor.memory = self->head->memory;
+    self->cursor.offset = 0u;
+    self->cursor.limit = self->committed;
+    self->cursor.threshold = 0u == config->largeThreshold ? SIZE_MAX : config->largeThreshold;
+    self->cursor.zeroing = ARENA_ZERO_ON_ALLOCATE == config->zeroing;
+    self->large = NULL;
+    self->adopted = NULL;
+    self->sibling = NULL;
+    self->consumed = 0u;
+    self->capacity = self->head->capacity;
+    self->marks = 0u;
+    self->maxBlockCapacity = 0u == config->maxBlockCapacity ? ARENA_MAX_BLOCK_CAPACITY : config->maxBlockCapacity;
+    self->growable = config->growable;
+    self->decommitOnClear = config->decommitOnClear;
+    self->zeroing = config->zeroing;
+    self->backend = config->backend;
+    self->alignment = alignment;
+    self->mapped = false;
+    self->owned = false;
+    self->handedOver = false;
+    assert(!config->adaptive || config->growable);
+    assert(!config->adaptive || NULL == config->reservoir);
+    assert(NULL == config->reservoir || maxAlign == alignment);
+    self->adaptive = config->adaptive;
+    self->reservoir = config->reservoir;
+    self->peak = 0u;
+    self->cycles = 0u;
+    memset(self->peaks, 0u, sizeof(self->peaks));
+#if ARENA_STATS_SUPPORT
+    memset(&self->stats, 0u, sizeof(self->stats));
+#endif
+#if ARENA_PROFILE_SUPPORT
+    self->sites = NULL;
+#endif
+#if !defined(NDEBUG)
+    self->savepoints = NULL;
+#endif
+}
+
+bool Arena_save(const struct Arena *const self, const void *const root, const char *const path) {
+    assert(NULL != self);
+    assert(NULL != root);
+    assert(NULL != path);
+    assert(self->head == self->current);
+    assert(NULL == self->large);
+    assert(NULL == self->adopted);
+    const char *const memory = self->head->memory;
+    assert((const char *) root >= memory && (const char *) root < &memory[self->cursor.offset]);
+    struct Snapshot snapshot = {
+            .version = ARENA_SNAPSHOT_VERSION,
+            .byteOrder = snapshotByteOrder,
+            .wordSize = sizeof(size_t),
+            .alignment = self->alignment,
+            .phase = (uintptr_t) memory & (maxAlignment - 1u),
+            .size = self->cursor.offset,
+            .root = (uint64_t) ((const char *) root - memory),
+    };
+    memcpy(snapshot.magic, snapshotMagic, sizeof(snapshot.magic));
+    FILE *const file = fopen(path, "wb");
+
+    if (NULL == file) {
+        return false;
+    }
+
+    // seeking past the header leaves a hole read back as zeros
+    const bool written = 1u == fwrite(&snapshot, sizeof(snapshot), 1u, file) &&
+                         0 == fseek(file, (long) (snapshotOffset + snapshot.phase), SEEK_SET) &&
+                         self->cursor.offset == fwrite(memory, 1u, self->cursor.offset, file);
+    return 0 == fclose(file) && written;
 }
 
 void *Arena_allocate(struct Arena *const self, const size_t alignment, const size_t size) {
     assert(NULL != self);
-    assert(alignment <= maxAlign);
+    assert(alignment <= maxAlignment);
     assert(isPowerOf2(alignment));
     assert(size > 0u);
-    char *const address = &self->memory[self->offset];
+    char *const address = &self->cursor.memory[self->cursor.offset];
     char *const alignedAddress = align(address, alignment);
     const size_t padding = alignedAddress - address;
+    const size_t available = self->cursor.limit - self->cursor.offset;
+
+    if (padding > available || size > available - padding || size > self->cursor.threshold) {
+        return Arena_allocateSlow(self, alignment, size);
+    }
+
+    self->cursor.offset += padding + size;
+#if ARENA_STATS_SUPPORT
+    Arena_record(self, padding, size);
+#endif
+    return self->cursor.zeroing ? memset(alignedAddress, 0u, size) : alignedAddress;
+}
+
+void *Arena_allocateArray(struct Arena *const self, const size_t alignment, const size_t count, const size_t size) {
+    assert(NULL != self);
+    assert(alignment <= maxAlignment);
+    assert(isPowerOf2(alignment));
+    assert(count > 0u);
+    assert(size > 0u);
 
-    if ((self->offset + padding + size) > self->capacity) {
+    if (count > SIZE_MAX / size) {
         panic("Out of memory");
     }
 
-    self->offset += padding + size;
-    return alignedAddress;
+    return Arena_allocate(self, alignment, count * size);
+}
+
+void Arena_allocateBatch(struct Arena *const self, const struct ArenaRequest *const requests, const size_t count,
+                         void **const memory) {
+    assert(NULL != self);
+    assert(NULL != requests);
+    assert(NULL != memory);
+    assert(count > 0u);
+    char *const start = &self->cursor.memory[self->cursor.offset];
+    const size_t available = self->cursor.limit - self->cursor.offset;
+    size_t offset = 0u;
+    size_t i = 0u;
+
+    // lay out the blocks against the current top taking the same padding Arena_allocate would take
+    for (; i < count; i++) {
+        const struct ArenaRequest *const request = &requests[i];
+        assert(request->alignment <= maxAlignment);
+        assert(isPowerOf2(request->alignment));
+        assert(request->size > 0u);
+        char *const address = align(&start[offset], request->alignment);
+        const size_t padding = (size_t) (address - &start[offset]);
+
+        if (padding > available - offset || request->size > available - offset - padding ||
+            request->size > self->cursor.threshold) {
+            break;
+        }
+
+        memory[i] = address;
+        offset += padding + request->size;
+    }
+
+    if (i == count) {
+        self->cursor.offset += offset;
+#if ARENA_STATS_SUPPORT
+        for (size_t j = 0u, end = 0u; j < count; j++) {
+            const size_t begin = (size_t) ((char *) memory[j] - start);
+            Arena_record(self, begin - end, requests[j].size);
+            end = begin + requests[j].size;
+        }
+#endif
+        if (self->cursor.zeroing) {
+            memset(memory[0], 0u, (size_t) (&start[offset] - (char *) memory[0]));
+        }
+
+        return;
+    }
+
+    // the batch does not fit: reserve it as a single block aligned to the strictest alignment
+    size_t alignment = 1u;
+    offset = 0u;
+
+    for (i = 0u; i < count; i++) {
+        const struct ArenaRequest *const request = &requests[i];
+        assert(request->alignment <= maxAlignment);
+        assert(isPowerOf2(request->alignment));
+        assert(request->size > 0u);
+        alignment = max(alignment, request->alignment);
+
+        if (offset > SIZE_MAX - request->alignment || request->size > SIZE_MAX - roundUp(offset, request->alignment)) {
+            panic("Out of memory");
+        }
+
+        offset = roundUp(offset, request->alignment) + request->size;
+    }
+
+#if ARENA_STATS_SUPPORT
+    const struct ArenaStats stats = self->stats;
+#endif
+    char *const base = Arena_allocate(self, alignment, offset);
+    offset = 0u;
+
+    for (i = 0u; i < count; i++) {
+        offset = roundUp(offset, requests[i].alignment);
+        memory[i] = &base[offset];
+        offset += requests[i].size;
+    }
+
+#if ARENA_STATS_SUPPORT
+    // account the requests one by one as the in-place path does, the leading padding goes to the first one
+    if (stats.largeAllocations == self->stats.largeAllocations) {
+        const size_t leading = self->stats.paddingBytes - stats.paddingBytes;
+        self->stats = stats;
+
+        for (size_t j = 0u, end = 0u; j < count; j++) {
+            const size_t begin = (size_t) ((char *) memory[j] - base);
+            Arena_record(self, (0u == j ? leading : 0u) + begin - end, requests[j].size);
+            end = begin + requests[j].size;
+        }
+    }
+#endif
 }
 
 void *Arena_clone(struct Arena *const self, const void *const data, const size_t alignment, const size_t size) {
     assert(NULL != self);
     assert(NULL != data);
-    assert(alignment <= maxAlign);
+    assert(alignment <= maxAlignment);
     assert(isPowerOf2(alignment));
     assert(size > 0u);
     return memcpy(Arena_allocate(self, alignment, size), data, size);
 }
 
+void *Arena_resize(struct Arena *const self, void *const memory, const size_t alignment, const size_t size,
+                   const size_t newSize, enum ArenaResize *const outcome) {
+    assert(NULL != self);
+    assert(!self->mapped);
+    assert(NULL != memory);
+    assert(alignment <= maxAlignment);
+    assert(isPowerOf2(alignment));
+    assert(isAligned(memory, alignment));
+    assert(size > 0u);
+    assert(newSize > 0u);
+    struct Block *const block = self->current;
+    char *const top = &block->memory[self->cursor.offset];
+    const bool isTop = (char *) memory >= block->memory && (char *) memory + size == top;
+
+    if (newSize <= size) {
+        if (isTop) {
+            if (ARENA_ZERO_ON_CLEAR == self->zeroing) {
+                memset((char *) memory + newSize, 0u, size - newSize);
+            }
+
+            self->cursor.offset -= size - newSize;
+        }
+
+        if (NULL != outcome) {
+            *outcome = ARENA_RESIZE_IN_PLACE;
+        }
+
+        return memory;
+    }
+
+    const size_t growth = newSize - size;
+
+    // the most recent large allocation grows in place within the slack of its mapping
+    if (NULL != self->large && memory == self->large->memory && newSize <= self->large->capacity) {
+        if (ARENA_ZERO_NEVER != self->zeroing) {
+            memset((char *) memory + size, 0u, growth);
+        }
+
+#if ARENA_STATS_SUPPORT
+        self->stats.largeBytes += growth;
+#endif
+
+        if (NULL != outcome) {
+            *outcome = ARENA_RESIZE_IN_PLACE;
+        }
+
+        return memory;
+    }
+
+    const size_t start = (char *) memory - block->memory;
+
+    if (isTop && newSize <= self->cursor.threshold && (newSize <= self->cursor.limit - start ||
+                  (ARENA_BACKEND_VIRTUAL == self->backend && self->head == block && Arena_commit(self, 1u, growth)))) {
+        if (ARENA_ZERO_ON_ALLOCATE == self->zeroing) {
+            memset(top, 0u, growth);
+        }
+
+        self->cursor.offset += growth;
+#if ARENA_STATS_SUPPORT
+        self->stats.requestedBytes += growth;
+        self->stats.consumedBytes += growth;
+        self->stats.highWaterMark = max(self->stats.highWaterMark, Arena_size(self));
+        self->stats.highWaterMarkSinceClear = max(self->stats.highWaterMarkSinceClear, Arena_size(self));
+#endif
+
+        if (NULL != outcome) {
+            *outcome = ARENA_RESIZE_IN_PLACE;
+        }
+
+        return memory;
+    }
+
+    if (NULL != outcome) {
+        *outcome = ARENA_RESIZE_MOVED;
+    }
+
+    return memcpy(Arena_allocate(self, alignment, newSize), memory, size);
+}
+
+void Arena_adopt(struct Arena *const self, struct Arena *const source) {
+    assert(NULL != self);
+    assert(NULL != source);
+    assert(self != source);
+    assert(!self->handedOver);
+    assert(!source->handedOver);
+    assert(!source->owned);
+    // the blocks of source, wherever they come from, are released by dropping it as a whole
+    source->handedOver = true;
+    source->sibling = self->adopted;
+    self->adopted = source;
+}
+
+void Arena_setOwned(struct Arena *const self) {
+    assert(NULL != self);
+    self->owned = true;
+}
+
+struct ArenaMark Arena_mark(struct Arena *const self) {
+    assert(NULL != self);
+    self->marks += 1u;
+#if defined(NDEBUG)
+    const size_t sequence = 0u;
+#else
+    const size_t sequence = Arena_pushSavepoint(self);
+#endif
+    return (struct ArenaMark) {
+            .arena = self,
+            .block = self->current,
+            .large = self->large,
+            .adopted = self->adopted,
+            .offset = self->cursor.offset,
+            .consumed = self->consumed,
+            .depth = self->marks,
+            .sequence = sequence,
+    };
+}
+
+void Arena_rewind(struct Arena *const self, const struct ArenaMark mark) {
+    assert(NULL != self);
+    assert(!self->mapped);
+    assert(self == mark.arena);
+    assert(NULL != mark.block);
+    assert(mark.depth > 0u && mark.depth <= self->marks);
+    assert(Arena_isValid(self, mark));
+    assert(mark.consumed + mark.offset <= Arena_size(self));
+    struct Block *const block = (struct Block *) mark.block;
+
+    if (ARENA_ZERO_ON_CLEAR == self->zeroing) {
+        if (block == self->current) {
+            memset(&block->memory[mark.offset], 0u, self->cursor.offset - mark.offset);
+        } else {
+            memset(&block->memory[mark.offset], 0u, Arena_limitOf(self, block) - mark.offset);
+
+            for (struct Block *current = block->next; current != self->current; current = current->next) {
+                assert(NULL != current);
+                memset(current->memory, 0u, Arena_limitOf(self, current));
+            }
+
+            memset(self->current->memory, 0u, self->cursor.offset);
+        }
+    }
+
+    Arena_releaseLarge(self, mark.large);
+    Arena_releaseAdopted(self, mark.adopted);
+
+    if (self->adaptive) {
+        self->peak = max(self->peak, Arena_size(self));
+    }
+
+    self->current = block;
+    self->cursor.memory = block->memory;
+    self->cursor.offset = mark.offset;
+    self->cursor.limit = Arena_limitOf(self, block);
+    self->consumed = mark.consumed;
+    self->marks = mark.depth;
+}
+
 void Arena_clear(struct Arena *const self) {
     assert(NULL != self);
-    const size_t capacity = self->capacity;
-    memset(self, 0u, sizeof(*self) + self->offset);
-    self->capacity = capacity;
+    assert(!self->mapped);
+    size_t retained = SIZE_MAX;
+
+    if (ARENA_BACKEND_VIRTUAL == self->backend && self->decommitOnClear) {
+        // decommitted pages read back as zero so only the retained ones are left to zero
+        retained = Arena_decommit(self);
+    }
+
+    if (NULL != self->reservoir) {
+        // blocks are given back as they are (takers zero them if needed), the first one is full if others were used
+        if (self->head != self->current) {
+            self->current = self->head;
+            self->cursor.offset = Arena_limitOf(self, self->head);
+        }
+
+        Arena_giveBack(self);
+    }
+
+    if (ARENA_ZERO_ON_CLEAR == self->zeroing) {
+        for (struct Block *block = self->head; block != self->current; block = block->next) {
+            memset(block->memory, 0u, min(Arena_limitOf(self, block), self->head == block ? retained : SIZE_MAX));
+        }
+
+        memset(self->current->memory, 0u, min(self->cursor.offset, self->head == self->current ? retained : SIZE_MAX));
+    }
+
+    Arena_releaseLarge(self, NULL);
+    Arena_releaseAdopted(self, NULL);
+
+    if (self->adaptive) {
+        Arena_adapt(self);
+    }
+
+    self->current = self->head;
+    self->cursor.memory = self->head->memory;
+    self->cursor.offset = 0u;
+    self->cursor.limit = self->committed;
+    self->consumed = 0u;
+    self->marks = 0u;
+#if ARENA_STATS_SUPPORT
+    self->stats.highWaterMarkSinceClear = 0u;
+    self->stats.clears += 1u;
+#endif
 }
 
 void Arena_drop(struct Arena *const self) {
     assert(NULL != self);
-    free(self);
+    struct Block *block = self->head->next;
+    Arena_releaseLarge(self, NULL);
+    Arena_releaseAdopted(self, NULL);
+#if ARENA_PROFILE_SUPPORT
+    free(self->sites);
+#endif
+#if !defined(NDEBUG)
+    free(self->savepoints);
+#endif
+
+    while (NULL != block) {
+        struct Block *const next = block->next;
+
+        if (NULL != self->reservoir) {
+            ArenaReservoir_give(self->reservoir, block);
+        } else {
+            free(block);
+        }
+
+        block = next;
+    }
+
+    if (ARENA_BACKEND_VIRTUAL == self->backend) {
+        Arena_unreserve(self);
+    } else if (self->mapped) {
+        Arena_unmap(self);
+        free(self);
+    } else if (!self->borrowed) {
+        free(self);
+    }
 }
 
 size_t Arena_available(const struct Arena *const self) {
     assert(NULL != self);
-    return self->capacity - self->offset;
+    return self->capacity - Arena_size(self);
 }
 
 size_t Arena_capacity(const struct Arena *const self) {
@@ -145,5 +926,567 @@ size_t Arena_capacity(const struct Arena *const self) {
 
 size_t Arena_size(const struct Arena *const self) {
     assert(NULL != self);
-    return self->offset;
+    return self->consumed + self->cursor.offset;
+}
+
+struct ArenaReservoir *ArenaReservoir_new(const size_t blockCapacity, const size_t maxIdle) {
+    assert(blockCapacity >= ARENA_MIN_CAPACITY);
+    assert(maxIdle > 0u);
+
+    if (maxIdle > (SIZE_MAX - sizeof(struct ArenaReservoir)) / sizeof(struct Slot)) {
+        panic("Out of memory");
+    }
+
+    struct ArenaReservoir *const self = aligned_alloc(ARENA_CACHE_LINE,
+                                                      sizeof(*self) + maxIdle * sizeof(self->slots[0]));
+
+    if (NULL != self) {
+        self->capacity = blockCapacity;
+        self->length = maxIdle;
+
+        Slots_init(self->slots, maxIdle);
+
+        return self;
+    }
+
+    panic("Out of memory");
+}
+
+size_t ArenaReservoir_idle(const struct ArenaReservoir *const self) {
+    assert(NULL != self);
+    return Slots_count(self->slots, self->length);
+}
+
+void ArenaReservoir_drop(struct ArenaReservoir *const self) {
+    assert(NULL != self);
+
+    for (size_t i = 0u; i < self->length; i++) {
+        free(Slot_take(&self->slots[i]));
+    }
+
+    free(self);
+}
+
+struct Block *ArenaReservoir_take(struct ArenaReservoir *const self, const enum ArenaZeroing zeroing) {
+    assert(NULL != self);
+    struct Block *const block = Slots_take(self->slots, self->length);
+
+    if (NULL == block) {
+        return Block_new(self->capacity, maxAlign, zeroing);
+    }
+
+    // idle blocks hold whatever their previous arena left in them
+    if (ARENA_ZERO_ON_CLEAR == zeroing) {
+        memset(block->memory, 0u, block->capacity);
+    }
+
+    block->next = NULL;
+    return block;
+}
+
+void ArenaReservoir_give(struct ArenaReservoir *const self, struct Block *const block) {
+    assert(NULL != self);
+    assert(NULL != block);
+
+    // blocks bigger than the others were made for a single request
+    if (block->capacity != self->capacity || !Slots_give(self->slots, self->length, block)) {
+        free(block);
+    }
+}
+
+#if ARENA_STATS_SUPPORT
+
+struct ArenaStats Arena_stats(const struct Arena *const self) {
+    assert(NULL != self);
+    return self->stats;
+}
+
+void Arena_record(struct Arena *const self, const size_t padding, const size_t size) {
+    assert(NULL != self);
+    size_t bucket = 0u;
+
+    for (size_t n = size; n > 1u && bucket < ARENA_STATS_BUCKETS - 1u; n >>= 1u) {
+        bucket += 1u;
+    }
+
+    const size_t arenaSize = Arena_size(self);
+    self->stats.allocations += 1u;
+    self->stats.requestedBytes += size;
+    self->stats.consumedBytes += padding + size;
+    self->stats.paddingBytes += padding;
+    self->stats.highWaterMark = max(self->stats.highWaterMark, arenaSize);
+    self->stats.highWaterMarkSinceClear = max(self->stats.highWaterMarkSinceClear, arenaSize);
+    self->stats.histogram[bucket] += 1u;
+}
+
+#endif
+
+#if ARENA_PROFILE_SUPPORT
+
+void *Arena_allocateAt(struct Arena *const self, const size_t alignment, const size_t size, const char *const site) {
+    assert(NULL != self);
+    assert(NULL != site);
+    const uintptr_t address = (uintptr_t) &self->cursor.memory[self->cursor.offset];
+    const size_t padding = (size_t) ((0u - address) & (alignment - 1u));
+    char *const memory = Arena_allocate(self, alignment, size);
+    // the memory comes right after the previous allocation or, if that did not fit, from the start of a new block;
+    // allocations bypassing the blocks take no padding
+    const char *const start = address + padding == (uintptr_t) memory ? (const char *) address : self->cursor.memory;
+    const bool isTop = &memory[size] == &self->cursor.memory[self->cursor.offset];
+    Arena_recordSite(self, site, isTop ? (size_t) (memory - start) : 0u, size);
+    return memory;
+}
+
+void *Arena_cloneAt(struct Arena *const self, const void *const data, const size_t alignment, const size_t size,
+                    const char *const site) {
+    assert(NULL != self);
+    assert(NULL != data);
+    assert(NULL != site);
+    return memcpy(Arena_allocateAt(self, alignment, size, site), data, size);
+}
+
+size_t Arena_sites(const struct Arena *const self, struct ArenaSite *const sites, const size_t count) {
+    assert(NULL != self);
+    assert(NULL != sites);
+    struct ArenaSite *const sorted = Arena_sortedSites(self);
+    const size_t length = NULL == self->sites ? 0u : min(count, self->sites->length);
+
+    if (length > 0u) {
+        memcpy(sites, sorted, length * sizeof(*sites));
+    }
+
+    free(sorted);
+    return length;
+}
+
+void Arena_dumpSites(const struct Arena *const self, FILE *const stream, const size_t count) {
+    assert(NULL != self);
+    assert(NULL != stream);
+    struct ArenaSite *const sorted = Arena_sortedSites(self);
+    const size_t length = NULL == self->sites ? 0u : min(count, self->sites->length);
+    fprintf(stream, "%12s %12s %12s  %s\n", "calls", "bytes", "padding", "site");
+
+    for (size_t i = 0u; i < length; i++) {
+        fprintf(stream, "%12zu %12zu %12zu  %s\n", sorted[i].calls, sorted[i].bytes, sorted[i].paddingBytes,
+                sorted[i].site);
+    }
+
+    free(sorted);
+}
+
+void Arena_dumpFolded(const struct Arena *const self, const char *const name, FILE *const stream) {
+    assert(NULL != self);
+    assert(NULL != name);
+    assert(NULL != stream);
+    struct ArenaSite *const sorted = Arena_sortedSites(self);
+
+    for (size_t i = 0u; NULL != self->sites && i < self->sites->length; i++) {
+        fprintf(stream, "%s;%s %zu\n", name, sorted[i].site, sorted[i].bytes + sorted[i].paddingBytes);
+    }
+
+    free(sorted);
+}
+
+void Arena_recordSite(struct Arena *const self, const char *const site, const size_t padding, const size_t size) {
+    assert(NULL != self);
+    assert(NULL != site);
+
+    struct SiteTable *table = self->sites;
+
+    if (NULL == table || 2u * (table->length + 1u) > table->capacity) {
+        const size_t capacity = NULL == table ? 64u : table->capacity * 2u;
+        struct SiteTable *const grown = calloc(1u, sizeof(*grown) + capacity * sizeof(grown->entries[0]));
+
+        if (NULL == grown) {
+            panic("Out of memory");
+        }
+
+        grown->capacity = capacity;
+        for (size_t i = 0u; NULL != table && i < table->capacity; i++) {
+            if (NULL != table->entries[i].site) {
+                *Arena_probeSite(grown->entries, capacity, table->entries[i].site) = table->entries[i];
+                grown->length += 1u;
+            }
+        }
+
+        free(table);
+        self->sites = table = grown;
+    }
+
+    struct ArenaSite *const entry = Arena_probeSite(table->entries, table->capacity, site);
+
+    if (NULL == entry->site) {
+        entry->site = site;
+        table->length += 1u;
+    }
+
+    entry->calls += 1u;
+    entry->bytes += size;
+    entry->paddingBytes += padding;
+}
+
+struct ArenaSite *Arena_probeSite(struct ArenaSite *const sites, const size_t capacity, const char *const site) {
+    assert(NULL != sites);
+    assert(NULL != site);
+    assert(isPowerOf2(capacity));
+    const size_t mask = capacity - 1u;
+    uint64_t hash = (uint64_t) (uintptr_t) site * 0x9e3779b97f4a7c15u;
+    hash ^= hash >> 32u;
+
+    for (size_t i = (size_t) hash & mask;; i = (i + 1u) & mask) {
+        if (NULL == sites[i].site || site == sites[i].site) {
+            return &sites[i];
+        }
+    }
+}
+
+struct ArenaSite *Arena_sortedSites(const struct Arena *const self) {
+    assert(NULL != self);
+    const struct SiteTable *const table = self->sites;
+    const size_t length = NULL == table ? 0u : table->length;
+    struct ArenaSite *const sorted = malloc(max(1u, length) * sizeof(*sorted));
+
+    if (NULL == sorted) {
+        panic("Out of memory");
+    }
+
+    for (size_t i = 0u, j = 0u; NULL != table && i < table->capacity; i++) {
+        if (NULL != table->entries[i].site) {
+            sorted[j++] = table->entries[i];
+        }
+    }
+
+    qsort(sorted, length, sizeof(*sorted), compareSites);
+    return sorted;
+}
+
+int compareSites(const void *const a, const void *const b) {
+    assert(NULL != a);
+    assert(NULL != b);
+    const struct ArenaSite *const x = a, *const y = b;
+    return (y->bytes > x->bytes) - (y->bytes < x->bytes);
 }
+
+#endif
+
+void *allocateMemory(const size_t size, const size_t alignment, const enum ArenaZeroing zeroing) {
+    assert(isPowerOf2(alignment));
+    void *memory;
+
+    // only arenas zeroing on clear rely on the backing memory being zeroed from the start
+    if (alignment <= maxAlign) {
+        memory = ARENA_ZERO_ON_CLEAR == zeroing ? calloc(1u, size) : malloc(size);
+    } else if (NULL != (memory = aligned_alloc(alignment, roundUp(size, alignment))) && ARENA_ZERO_ON_CLEAR == zeroing) {
+        memset(memory, 0u, size);
+    }
+
+    if (NULL != memory) {
+        return memory;
+    }
+
+    panic("Out of memory");
+}
+
+struct Block *Block_new(const size_t capacity, const size_t alignment, const enum ArenaZeroing zeroing) {
+    const size_t header = roundUp(sizeof(struct Block), alignment);
+
+    if (capacity > SIZE_MAX - header - alignment) {
+        panic("Out of memory");
+    }
+
+    struct Block *const self = allocateMemory(header + capacity, alignment, zeroing);
+    self->next = NULL;
+    self->capacity = capacity;
+    self->memory = (char *) self + header;
+    return self;
+}
+
+void *Arena_allocateSlow(struct Arena *const self, const size_t alignment, const size_t size) {
+    assert(NULL != self);
+
+    if (size > self->cursor.threshold) {
+        return Arena_allocateLarge(self, alignment, size);
+    }
+
+    if (ARENA_BACKEND_VIRTUAL == self->backend && self->head == self->current && Arena_commit(self, alignment, size)) {
+        return Arena_allocate(self, alignment, size);
+    }
+
+    if (!self->growable || size > SIZE_MAX - alignment) {
+        panic("Out of memory");
+    }
+
+    // blocks memory is aligned to the base alignment so this is the worst case padding
+    const size_t required = alignment > self->alignment ? size + alignment - self->alignment : size;
+    struct Block *block = self->current->next;
+
+    if (NULL == block || block->capacity < required) {
+        if (NULL != self->reservoir && required <= self->reservoir->capacity) {
+            block = ArenaReservoir_take(self->reservoir, self->zeroing);
+        } else {
+            const size_t capacity = self->current->capacity;
+            const size_t doubled = capacity > SIZE_MAX / 2u ? SIZE_MAX : capacity * 2u;
+            block = Block_new(max(required, doubled < self->maxBlockCapacity ? doubled : self->maxBlockCapacity),
+                              self->alignment, self->zeroing);
+        }
+
+        block->next = self->current->next;
+        self->current->next = block;
+        self->capacity += block->capacity;
+    }
+
+    self->consumed += self->current->capacity;
+    self->current = block;
+    self->cursor.memory = block->memory;
+    self->cursor.offset = 0u;
+    self->cursor.limit = block->capacity;
+    return Arena_allocate(self, alignment, size);
+}
+
+size_t Arena_limitOf(const struct Arena *const self, const struct Block *const block) {
+    assert(NULL != self);
+    assert(NULL != block);
+    return self->head == block ? self->committed : block->capacity;
+}
+
+#if defined(__linux__)
+
+struct Arena *Arena_reserve(const size_t capacity, const size_t alignment, const bool hugePages) {
+    const size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    const size_t granularity = hugePages ? hugePageSize : max(pageSize, ARENA_COMMIT_GRANULARITY);
+    const size_t headers = roundUp(sizeof(struct Arena) + sizeof(struct Block), alignment);
+
+    if (capacity > SIZE_MAX - headers - 2u * granularity) {
+        panic("Out of memory");
+    }
+
+    // over-reserve by one granule so that the mapping can be aligned to the commit granularity
+    const size_t length = roundUp(headers + capacity, granularity);
+    char *const mapping = mmap(NULL, length + granularity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (MAP_FAILED == mapping) {
+        panic("Out of memory");
+    }
+
+    char *const base = (char *) roundUp((uintptr_t) mapping, granularity);
+    const size_t leading = base - mapping;
+    const size_t trailing = granularity - leading;
+
+    if ((leading > 0u && 0 != munmap(mapping, leading)) || (trailing > 0u && 0 != munmap(base + length, trailing))) {
+        panic("Unable to trim the reserved memory");
+    }
+
+    if (hugePages) {
+        madvise(base, length, MADV_HUGEPAGE);   // just a hint, failures are not relevant
+    }
+
+    if (0 != mprotect(base, granularity, PROT_READ | PROT_WRITE)) {
+        panic("Out of memory");
+    }
+
+    struct Arena *const self = (struct Arena *) base;
+    self->head = (struct Block *) (self + 1);
+    self->head->capacity = length - headers;
+    self->head->memory = base + headers;
+    self->committed = granularity - headers;
+    self->granularity = granularity;
+    return self;
+}
+
+bool Arena_commit(struct Arena *const self, const size_t alignment, const size_t size) {
+    assert(NULL != self);
+    assert(ARENA_BACKEND_VIRTUAL == self->backend);
+    assert(self->head == self->current);
+    struct Block *const block = self->head;
+    char *const address = &block->memory[self->cursor.offset];
+    const size_t padding = (char *) align(address, alignment) - address;
+    const size_t available = block->capacity - self->cursor.offset;
+
+    if (padding > available || size > available - padding) {
+        return false;
+    }
+
+    // committed memory always ends on a granule boundary, as does the reserved one
+    const size_t end = self->cursor.offset + padding + size;
+    const size_t committed = roundUp((uintptr_t) &block->memory[end], self->granularity) - (uintptr_t) block->memory;
+    assert(committed <= block->capacity);
+
+    if (0 != mprotect(&block->memory[self->committed], committed - self->committed, PROT_READ | PROT_WRITE)) {
+        panic("Out of memory");
+    }
+
+    self->committed = committed;
+    self->cursor.limit = committed;
+    return true;
+}
+
+size_t Arena_decommit(struct Arena *const self) {
+    assert(NULL != self);
+    assert(ARENA_BACKEND_VIRTUAL == self->backend);
+    // the first granule holding the headers is retained
+    const size_t retained = self->granularity - (self->head->memory - (char *) self);
+
+    if (self->committed > retained &&
+        0 != madvise(&self->head->memory[retained], self->committed - retained, MADV_DONTNEED)) {
+        panic("Unable to decommit memory");
+    }
+
+    return retained;
+}
+
+void Arena_unreserve(struct Arena *const self) {
+    assert(NULL != self);
+    assert(ARENA_BACKEND_VIRTUAL == self->backend);
+    munmap(self, (self->head->memory - (char *) self) + self->head->capacity);
+}
+
+struct Block *Block_map(const size_t capacity, const size_t alignment) {
+    assert(isPowerOf2(alignment));
+    const size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    const size_t granularity = max(pageSize, alignment);
+    const size_t header = roundUp(sizeof(struct Block), alignment);
+
+    if (capacity > SIZE_MAX - header - 2u * granularity) {
+        panic("Out of memory");
+    }
+
+    // over-map alignments bigger than a page so that the mapping can be aligned
+    const size_t length = roundUp(header + capacity, pageSize);
+    const size_t slack = granularity - pageSize;
+    char *const mapping = mmap(NULL, length + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (MAP_FAILED == mapping) {
+        panic("Out of memory");
+    }
+
+    char *const base = (char *) roundUp((uintptr_t) mapping, granularity);
+    const size_t leading = base - mapping;
+    const size_t trailing = slack - leading;
+
+    if ((leading > 0u && 0 != munmap(mapping, leading)) || (trailing > 0u && 0 != munmap(base + length, trailing))) {
+        panic("Unable to trim the mapped memory");
+    }
+
+    // the tail of the last page is usable, e.g. by Arena_resize
+    struct Block *const self = (struct Block *) base;
+    self->next = NULL;
+    self->capacity = length - header;
+    self->memory = base + header;
+    return self;
+}
+
+void Block_unmap(struct Block *const self) {
+    assert(NULL != self);
+    munmap(self, (self->memory - (char *) self) + self->capacity);
+}
+
+struct Arena *Arena_load(const char *const path, const void **const root) {
+    assert(NULL != path);
+    assert(NULL != root);
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    struct stat status;
+
+    if (fd < 0) {
+        return NULL;
+    }
+
+    if (0 != fstat(fd, &status) || (size_t) status.st_size < snapshotOffset) {
+        close(fd);
+        return NULL;
+    }
+
+    const size_t length = (size_t) status.st_size;
+    char *const mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (MAP_FAILED == mapping) {
+        return NULL;
+    }
+
+    const struct Snapshot *const snapshot = (const struct Snapshot *) mapping;
+
+    // mappings are page aligned, pages smaller than ARENA_MAX_ALIGNMENT cannot preserve the phase
+    if (0u != ((uintptr_t) mapping & (maxAlignment - 1u)) ||
+        0 != memcmp(snapshot->magic, snapshotMagic, sizeof(snapshot->magic)) ||
+        ARENA_SNAPSHOT_VERSION != snapshot->version ||
+        snapshotByteOrder != snapshot->byteOrder ||
+        sizeof(size_t) != snapshot->wordSize ||
+        !isPowerOf2(snapshot->alignment) || snapshot->alignment > maxAlignment ||
+        snapshot->phase >= maxAlignment || 0u != (snapshot->phase & (snapshot->alignment - 1u)) ||
+        length - snapshotOffset < snapshot->phase ||
+        snapshot->size != length - snapshotOffset - snapshot->phase ||
+        snapshot->root >= snapshot->size) {
+        munmap(mapping, length);
+        return NULL;
+    }
+
+    struct Arena *const self = malloc(sizeof(*self) + sizeof(*self->head));
+
+    if (NULL == self) {
+        panic("Out of memory");
+    }
+
+    self->head = (struct Block *) (self + 1);
+    self->head->capacity = (size_t) snapshot->size;
+    self->head->memory = &mapping[snapshotOffset + snapshot->phase];
+    self->committed = self->head->capacity;
+    self->granularity = 0u;
+    self->borrowed = false;
+    Arena_init(self, &(struct ArenaConfig) {.zeroing = ARENA_ZERO_NEVER}, (size_t) snapshot->alignment);
+    self->mapped = true;
+    self->cursor.offset = self->head->capacity;
+    *root = &self->head->memory[snapshot->root];
+    return self;
+}
+
+void Arena_unmap(struct Arena *const self) {
+    assert(NULL != self);
+    assert(self->mapped);
+    const size_t phase = (uintptr_t) self->head->memory & (maxAlignment - 1u);
+    munmap(self->head->memory - snapshotOffset - phase, snapshotOffset + phase + self->head->capacity);
+}
+
+#else
+
+struct Arena *Arena_reserve(const size_t capacity, const size_t alignment, const bool hugePages) {
+    (void) capacity;
+    (void) alignment;
+    (void) hugePages;
+    panic("ARENA_BACKEND_VIRTUAL is not supported on this platform");
+}
+
+bool Arena_commit(struct Arena *const self, const size_t alignment, const size_t size) {
+    (void) self;
+    (void) alignment;
+    (void) size;
+    return false;
+}
+
+size_t Arena_decommit(struct Arena *const self) {
+    (void) self;
+    return SIZE_MAX;
+}
+
+void Arena_unreserve(struct Arena *const self) {
+    (void) self;
+}
+
+struct Block *Block_map(const size_t capacity, const size_t alignment) {
+    return Block_new(capacity, alignment, ARENA_ZERO_ON_CLEAR);
+}
+
+void Block_unmap(struct Block *const self) {
+    free(self);
+}
+
+struct Arena *Arena_load(const char *const path, const void **const root) {
+    (void) path;
+    (void) root;
+    panic("Arena_load is not supported on this platform");
+}
+
+void Arena_unmap(struct Arena *const self) {
+    (void) self;
+}
+
+#endif
@@ -31,7 +31,11 @@
 extern "C" {
 #endif
 
+#include <assert.h>
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 #if !defined(ARENA_DEFAULT_CAPACITY)
 #define ARENA_DEFAULT_CAPACITY  512u
@@ -41,12 +45,346 @@ extern "C" {
 #define ARENA_MIN_CAPACITY      32u
 #endif
 
+#if !defined(ARENA_MAX_BLOCK_CAPACITY)
+#define ARENA_MAX_BLOCK_CAPACITY 1048576u
+#endif
+
+#if !defined(ARENA_MAX_ALIGNMENT)
+#define ARENA_MAX_ALIGNMENT     4096u
+#endif
+
+#if !defined(ARENA_DEFAULT_RESERVE)
+#define ARENA_DEFAULT_RESERVE   1073741824u
+#endif
+
+#if !defined(ARENA_COMMIT_GRANULARITY)
+#define ARENA_COMMIT_GRANULARITY 65536u
+#endif
+
+#if !defined(ARENA_BUFFER_OVERHEAD)
+#define ARENA_BUFFER_OVERHEAD   1024u
+#endif
+
+#if !defined(ARENA_CACHE_LINE)
+#define ARENA_CACHE_LINE        64u
+#endif
+
+#if !defined(ARENA_STATS_SUPPORT)
+#define ARENA_STATS_SUPPORT     0
+#endif
+
+#if !defined(ARENA_PROFILE_SUPPORT)
+#define ARENA_PROFILE_SUPPORT   0
+#endif
+
+#if !defined(ARENA_STATS_BUCKETS)
+#define ARENA_STATS_BUCKETS     16u
+#endif
+
+#if !defined(ARENA_ADAPTIVE_WINDOW)
+#define ARENA_ADAPTIVE_WINDOW   8u
+#endif
+
+#if !defined(ARENA_SNAPSHOT_VERSION)
+#define ARENA_SNAPSHOT_VERSION  1u
+#endif
+
 #if !defined(__GNUC__)
 #define __attribute__(...)
 #endif
 
+#if ARENA_PROFILE_SUPPORT
+#include <stdio.h>
+#include <trace/trace.h>
+#endif
+
 struct Arena;
 
+/**
+ * A thread-safe reservoir of blocks of the same capacity shared by arenas, see ArenaConfig::reservoir.
+ * Idle blocks are kept in a bounded set of lock-free slots.
+ */
+struct ArenaReservoir;
+
+/**
+ * Allocation statistics of an arena, collected only if ARENA_STATS_SUPPORT is enabled.
+ */
+struct ArenaStats {
+    /**
+     * The number of allocations performed.
+     */
+    size_t allocations;
+
+    /**
+     * The bytes requested by the allocations.
+     */
+    size_t requestedBytes;
+
+    /**
+     * The bytes consumed by the allocations (requested bytes plus alignment padding).
+     */
+    size_t consumedBytes;
+
+    /**
+     * The bytes lost to alignment padding.
+     */
+    size_t paddingBytes;
+
+    /**
+     * The peak of Arena_size since the creation of the arena.
+     */
+    size_t highWaterMark;
+
+    /**
+     * The peak of Arena_size since the last clear.
+     */
+    size_t highWaterMarkSinceClear;
+
+    /**
+     * The number of clears performed.
+     */
+    size_t clears;
+
+    /**
+     * The number of allocations by requested size: bucket i counts sizes in [2^i, 2^(i+1)),
+     * the last bucket counts all the bigger ones.
+     */
+    size_t histogram[ARENA_STATS_BUCKETS];
+
+    /**
+     * The number of allocations bypassing the blocks, see ArenaConfig::largeThreshold.
+     * They are not counted by the fields above.
+     */
+    size_t largeAllocations;
+
+    /**
+     * The bytes requested by the allocations bypassing the blocks.
+     */
+    size_t largeBytes;
+};
+
+/**
+ * The allocations of an arena made from a call site, collected only if ARENA_PROFILE_SUPPORT is enabled.
+ */
+struct ArenaSite {
+    /**
+     * The call site as file:line.
+     */
+    const char *site;
+
+    /**
+     * The number of allocations performed.
+     */
+    size_t calls;
+
+    /**
+     * The bytes requested by the allocations.
+     */
+    size_t bytes;
+
+    /**
+     * The bytes lost to alignment padding.
+     */
+    size_t paddingBytes;
+};
+
+/**
+ * When the memory handed out by an arena gets zeroed.
+ */
+enum ArenaZeroing {
+    /**
+     * The backing memory is zeroed at creation and the used memory on every clear,
+     * so allocations always return zeroed memory.
+     */
+    ARENA_ZERO_ON_CLEAR = 0,
+
+    /**
+     * The memory is never zeroed, clearing is O(1) and allocations return uninitialized memory.
+     */
+    ARENA_ZERO_NEVER,
+
+    /**
+     * Only the bytes handed out by each allocation are zeroed, clearing is O(1).
+     */
+    ARENA_ZERO_ON_ALLOCATE,
+};
+
+/**
+ * Where the memory of an arena comes from.
+ */
+enum ArenaBackend {
+    /**
+     * The memory is taken from the heap.
+     */
+    ARENA_BACKEND_HEAP = 0,
+
+    /**
+     * The capacity is reserved as a range of virtual memory and pages are committed
+     * only as the arena grows across them, so resident memory tracks the actual usage.
+     * Available on Linux only.
+     */
+    ARENA_BACKEND_VIRTUAL,
+};
+
+/**
+ * The bump state of an arena, it is the leading member of struct Arena.
+ * 
+ * @attention this struct must be treated as opaque therefore its members should not be accessed directly.
+ */
+struct ArenaCursor {
+    char *memory;
+    size_t offset;
+    size_t limit;
+    size_t threshold;
+    bool zeroing;
+};
+
+/**
+ * Creation parameters of an arena.
+ * Zeroed fields select the default behaviour.
+ */
+struct ArenaConfig {
+    /**
+     * The initial capacity, if 0 ARENA_DEFAULT_CAPACITY is used
+     * (ARENA_DEFAULT_RESERVE for ARENA_BACKEND_VIRTUAL arenas).
+     */
+    size_t capacity;
+
+    /**
+     * The upper bound for the geometric growth of blocks, if 0 ARENA_MAX_BLOCK_CAPACITY is used.
+     * Requests bigger than this value always get a block large enough to hold them.
+     */
+    size_t maxBlockCapacity;
+
+    /**
+     * If true, when the current block is exhausted a new block is linked in
+     * instead of treating it as an out of memory error.
+     */
+    bool growable;
+
+    /**
+     * The zeroing policy of the arena.
+     */
+    enum ArenaZeroing zeroing;
+
+    /**
+     * The backend providing the memory of the first block.
+     */
+    enum ArenaBackend backend;
+
+    /**
+     * The alignment of the memory of every block of the arena, if 0 alignof(max_align_t) is used.
+     * Must be a power of 2 not greater than ARENA_MAX_ALIGNMENT.
+     */
+    size_t alignment;
+
+    /**
+     * If true, ARENA_BACKEND_VIRTUAL arenas give their committed pages back to the OS on clear.
+     */
+    bool decommitOnClear;
+
+    /**
+     * If true, ARENA_BACKEND_VIRTUAL arenas hint the OS to back them with transparent huge pages.
+     */
+    bool hugePages;
+
+    /**
+     * Requests bigger than this value bypass the blocks getting a dedicated mapping of their own,
+     * even if the arena is not growable, so that the blocks are not grown to hold them.
+     * Dedicated mappings are released by Arena_clear, Arena_rewind and Arena_drop
+     * and are not counted by Arena_size and Arena_capacity. If 0 no request bypasses the blocks.
+     */
+    size_t largeThreshold;
+
+    /**
+     * If true, the arena tracks its peak size over the last ARENA_ADAPTIVE_WINDOW clear cycles and
+     * on clear resizes the blocks following the first one (whose capacity is the lower bound) into
+     * a single block fitting that peak. It grows right after a cycle needing more memory
+     * but shrinks only once a whole window used less than a quarter of it.
+     * Requires growable.
+     */
+    bool adaptive;
+
+    /**
+     * If not NULL, growable arenas take the blocks following the first one from the reservoir
+     * (unless a request needs a bigger block) and give them back on clear and drop instead of keeping them.
+     * The reservoir must outlive the arena. Incompatible with adaptive and with alignments
+     * bigger than alignof(max_align_t).
+     */
+    struct ArenaReservoir *reservoir;
+};
+
+/**
+ * How Arena_resize fulfilled a request.
+ */
+enum ArenaResize {
+    /**
+     * The allocation was resized in place, its address did not change.
+     */
+    ARENA_RESIZE_IN_PLACE = 0,
+
+    /**
+     * The allocation was copied to a new block of memory, the old one stays allocated.
+     */
+    ARENA_RESIZE_MOVED,
+};
+
+/**
+ * Describes a block of memory to be allocated by Arena_allocateBatch.
+ */
+struct ArenaRequest {
+    size_t alignment;
+    size_t size;
+};
+
+/**
+ * A savepoint of an arena obtained by calling Arena_mark.
+ * 
+ * @attention this struct must be treated as opaque therefore its members should not be accessed directly.
+ */
+struct ArenaMark {
+    const struct Arena *arena;
+    const void *block;
+    const void *large;
+    const void *adopted;
+    size_t offset;
+    size_t consumed;
+    size_t depth;
+    size_t sequence;
+};
+
+/**
+ * A pointer stored as the distance between its own address and the target one (0 stands for NULL),
+ * structures linked by relative pointers stay valid wherever their memory is mapped, e.g. by Arena_load.
+ */
+struct ArenaRelative {
+    intptr_t offset;
+};
+
+/**
+ * Makes self point to target (which may be NULL).
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (target == self) is a checked runtime error.
+ */
+static inline __attribute__((__nonnull__(1)))
+void ArenaRelative_set(struct ArenaRelative *const self, const void *const target) {
+    assert(NULL != self);
+    assert((const void *) self != target);
+    self->offset = NULL == target ? 0 : (intptr_t) target - (intptr_t) self;
+}
+
+/**
+ * Gets the address pointed by self, NULL if self does not point anywhere.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+static inline __attribute__((__warn_unused_result__, __nonnull__(1)))
+void *ArenaRelative_get(const struct ArenaRelative *const self) {
+    assert(NULL != self);
+    return 0 == self->offset ? NULL : (void *) ((intptr_t) self + self->offset);
+}
+
 /**
  * Creates a new arena with default capacity.
  * 
@@ -64,17 +402,165 @@ __attribute__((__warn_unused_result__));
 extern struct Arena *Arena_withCapacity(size_t capacity)
 __attribute__((__warn_unused_result__, __alloc_size__(1)));
 
+/**
+ * Creates a new arena using the specified configuration.
+ * 
+ * @attention (NULL == config) is a checked runtime error.
+ * @attention Invalid alignment values are checked runtime errors.
+ * @attention (config->adaptive && !config->growable) is a checked runtime error.
+ * @attention (config->adaptive && NULL != config->reservoir) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern struct Arena *Arena_withConfig(const struct ArenaConfig *config)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Creates a new arena inside a buffer provided by the caller (stack, static or shared memory)
+ * without allocating memory, the header of the arena takes at most ARENA_BUFFER_OVERHEAD bytes
+ * of the buffer (using the default alignment).
+ * config->capacity is ignored; if config->growable is true, the arena spills to heap allocated
+ * blocks once the buffer is exhausted. Arenas using ARENA_ZERO_ON_CLEAR zero the buffer.
+ * Arena_drop releases the spilled blocks only, the buffer is never freed.
+ * 
+ * @attention (NULL == buffer) is a checked runtime error.
+ * @attention (NULL == config) is a checked runtime error.
+ * @attention (ARENA_BACKEND_HEAP != config->backend) is a checked runtime error.
+ * @attention Invalid alignment values are checked runtime errors.
+ * @attention A buffer too small to hold the header and ARENA_MIN_CAPACITY bytes is a checked runtime error.
+ */
+extern struct Arena *Arena_fromBuffer(void *buffer, size_t size, const struct ArenaConfig *config)
+__attribute__((__warn_unused_result__, __nonnull__(1, 3)));
+
+/**
+ * Writes the used memory of the arena to the file at path, preceded by a small versioned header
+ * recording the base alignment of the arena and the offset of root.
+ * Structures meant to be reloaded with Arena_load must link their parts by ArenaRelative pointers.
+ * Returns false (leaving errno set) if the file cannot be written.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == root) is a checked runtime error.
+ * @attention (NULL == path) is a checked runtime error.
+ * @attention Saving an arena whose used memory spans more than its first block is a checked runtime error.
+ * @attention Saving an arena holding large allocations (see ArenaConfig::largeThreshold) is a checked runtime error.
+ * @attention Saving an arena that adopted other arenas is a checked runtime error.
+ * @attention root not pointing into the used memory of the arena is a checked runtime error.
+ */
+extern bool Arena_save(const struct Arena *self, const void *root, const char *path)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2, 3)));
+
+/**
+ * Maps the file at path written by Arena_save read-only as an arena without copying nor parsing its content,
+ * storing the address of the saved root in root; pages are loaded lazily and shared with the page cache.
+ * The arena is full: allocating from it is an out of memory error, as it is not growable,
+ * and it cannot be rewound, cleared nor resized.
+ * Returns NULL if the file cannot be read or was not written by a compatible Arena_save
+ * (other version, byte order or word size) so that callers can rebuild their data.
+ *
+ * @attention (NULL == path) is a checked runtime error.
+ * @attention (NULL == root) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern struct Arena *Arena_load(const char *path, const void **root)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2)));
+
 /**
  * Returns a block of allocated memory of the specified size using the specified alignment.
+ * Any power of 2 up to ARENA_MAX_ALIGNMENT is a valid alignment, the padding it takes counts in Arena_size.
  *
  * @attention (NULL == self) is a checked runtime error.
  * @attention Invalid alignment values are checked runtime errors.
  * @attention (0 == size) is a checked runtime error.
- * @attention Out of memory is a checked runtime error.
+ * @attention Out of memory is a checked runtime error (unless the arena is growable).
  */
 extern void *Arena_allocate(struct Arena *self, size_t alignment, size_t size)
 __attribute__((__warn_unused_result__, __nonnull__(1), __alloc_size__(3)));
 
+/**
+ * Same as Arena_allocate but the bump of the pointer is inlined at the call site,
+ * only refilling the arena and error handling are performed out-of-line.
+ * Constant sizes and alignments are folded by the compiler.
+ * If ARENA_STATS_SUPPORT is enabled this is just a call to Arena_allocate.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention Invalid alignment values are checked runtime errors.
+ * @attention (0 == size) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error (unless the arena is growable).
+ */
+static inline __attribute__((__always_inline__, __warn_unused_result__, __nonnull__(1), __alloc_size__(3)))
+void *Arena_allocateInline(struct Arena *const self, const size_t alignment, const size_t size) {
+#if ARENA_STATS_SUPPORT
+    return Arena_allocate(self, alignment, size);
+#else
+    assert(NULL != self);
+    assert(alignment > 0u && alignment <= ARENA_MAX_ALIGNMENT && 0u == (alignment & (alignment - 1u)));
+    assert(size > 0u);
+    struct ArenaCursor *const cursor = (struct ArenaCursor *) self;
+    const uintptr_t address = (uintptr_t) &cursor->memory[cursor->offset];
+    const size_t padding = (size_t) ((0u - address) & (alignment - 1u));
+    const size_t available = cursor->limit - cursor->offset;
+
+    if (padding <= available && size <= available - padding && size <= cursor->threshold) {
+        char *const alignedAddress = &cursor->memory[cursor->offset + padding];
+        cursor->offset += padding + size;
+        return cursor->zeroing ? memset(alignedAddress, 0u, size) : alignedAddress;
+    }
+
+    return Arena_allocate(self, alignment, size);
+#endif
+}
+
+/**
+ * Allocates an object of type T using Arena_allocateInline.
+ * If ARENA_PROFILE_SUPPORT is enabled the allocation is recorded as Arena_allocateTraced does.
+ */
+#if ARENA_PROFILE_SUPPORT
+#define Arena_make(self, T) \
+    ((T *) Arena_allocateAt((self), _Alignof(T), sizeof(T), __TRACE__))
+#else
+#define Arena_make(self, T) \
+    ((T *) Arena_allocateInline((self), _Alignof(T), sizeof(T)))
+#endif
+
+/**
+ * Returns a block of allocated memory for count elements of the specified size using the specified alignment.
+ * Unlike passing count * size to Arena_allocate, the multiplication is checked for overflow.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention Invalid alignment values are checked runtime errors.
+ * @attention (0 == count) is a checked runtime error.
+ * @attention (0 == size) is a checked runtime error.
+ * @attention Overflows of count * size are checked runtime errors.
+ * @attention Out of memory is a checked runtime error (unless the arena is growable).
+ */
+extern void *Arena_allocateArray(struct Arena *self, size_t alignment, size_t count, size_t size)
+__attribute__((__warn_unused_result__, __nonnull__(1), __alloc_size__(3, 4)));
+
+/**
+ * Allocates an array of count objects of type T using Arena_allocateArray.
+ */
+#define Arena_makeArray(self, T, count) \
+    ((T *) Arena_allocateArray((self), _Alignof(T), (count), sizeof(T)))
+
+/**
+ * Allocates count blocks of memory as described by requests with a single capacity check,
+ * storing the address of the i-th block in memory[i].
+ * Blocks are laid out contiguously in order, each one aligned as requested.
+ * If the batch fits the current block the result is the same as calling Arena_allocate for each request,
+ * otherwise the batch is allocated as a whole, aligned to the strictest alignment of the requests,
+ * so the padding before the first block may differ.
+ * Statistics count every request as an allocation of its own, unless the batch as a whole
+ * bypasses the blocks (see ArenaConfig::largeThreshold) in which case it counts as a single large allocation.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == requests) is a checked runtime error.
+ * @attention (NULL == memory) is a checked runtime error.
+ * @attention (0 == count) is a checked runtime error.
+ * @attention Invalid alignment values or (0 == size) in any request are checked runtime errors.
+ * @attention Out of memory is a checked runtime error (unless the arena is growable).
+ */
+extern void Arena_allocateBatch(struct Arena *self, const struct ArenaRequest *requests, size_t count, void **memory)
+__attribute__((__nonnull__(1, 2, 4)));
+
 /**
  * Clones and returns the object pointed by data.
  *
@@ -87,12 +573,99 @@ __attribute__((__warn_unused_result__, __nonnull__(1), __alloc_size__(3)));
 extern void *Arena_clone(struct Arena *self, const void *data, size_t alignment, size_t size)
 __attribute__((__warn_unused_result__, __nonnull__(1, 2), __alloc_size__(4)));
 
+/**
+ * Same as Arena_allocate, recording the call site in the profile of the arena if ARENA_PROFILE_SUPPORT is enabled,
+ * otherwise this is just a call to Arena_allocate.
+ */
+#if ARENA_PROFILE_SUPPORT
+#define Arena_allocateTraced(self, alignment, size) \
+    Arena_allocateAt((self), (alignment), (size), __TRACE__)
+#else
+#define Arena_allocateTraced(self, alignment, size) \
+    Arena_allocate((self), (alignment), (size))
+#endif
+
+/**
+ * Same as Arena_clone, recording the call site in the profile of the arena if ARENA_PROFILE_SUPPORT is enabled,
+ * otherwise this is just a call to Arena_clone.
+ */
+#if ARENA_PROFILE_SUPPORT
+#define Arena_cloneTraced(self, data, alignment, size) \
+    Arena_cloneAt((self), (data), (alignment), (size), __TRACE__)
+#else
+#define Arena_cloneTraced(self, data, alignment, size) \
+    Arena_clone((self), (data), (alignment), (size))
+#endif
+
+/**
+ * Resizes a block of memory obtained from this arena returning its (possibly new) address.
+ * If memory is the most recent allocation of the arena it is grown or shrunk in place by moving the offset,
+ * shrinking is always performed in place; otherwise a new block is allocated and the content is copied.
+ * If outcome is not NULL it is set to the path taken.
+ * Bytes exceeding size follow the zeroing policy of the arena.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == memory) is a checked runtime error.
+ * @attention Invalid alignment values are checked runtime errors.
+ * @attention (0 == size) is a checked runtime error.
+ * @attention (0 == newSize) is a checked runtime error.
+ * @attention Resizing in an arena obtained by Arena_load is a checked runtime error.
+ * @attention Out of memory is a checked runtime error (unless the arena is growable).
+ */
+extern void *Arena_resize(struct Arena *self, void *memory, size_t alignment, size_t size, size_t newSize,
+                          enum ArenaResize *outcome)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2), __alloc_size__(5)));
+
+/**
+ * Transfers the ownership of all the memory of source to the arena in O(1), without copying anything:
+ * references obtained from source stay valid until the arena is cleared, dropped or rewound to a savepoint
+ * taken before this call, which release source as Arena_drop would.
+ * The memory of source is not counted by Arena_size and Arena_capacity of the arena.
+ *
+ * After calling this method source is invalidated: it must not be used nor dropped anymore.
+ * Buffers of sources created by Arena_fromBuffer must outlive the arena.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == source) is a checked runtime error.
+ * @attention (self == source) is a checked runtime error.
+ * @attention Adopting an arena already adopted, or into one, is a checked runtime error.
+ * @attention Adopting an arena owned by ArenaPool, FrameArena or ThreadArena is a checked runtime error.
+ */
+extern void Arena_adopt(struct Arena *self, struct Arena *source)
+__attribute__((__nonnull__(1, 2)));
+
+/**
+ * Returns a savepoint capturing the current state of the arena.
+ * Unless NDEBUG is defined, the arena keeps track of the savepoints still valid to check Arena_rewind.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error (unless NDEBUG is defined).
+ */
+extern struct ArenaMark Arena_mark(struct Arena *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Rewinds the arena to the specified savepoint releasing (without freeing memory)
+ * everything allocated after it in O(1); arenas using ARENA_ZERO_ON_CLEAR zero the released memory.
+ * All references obtained by calling Arena_allocate after the savepoint was taken are invalidated,
+ * as are the savepoints taken after it, while mark itself may be used again.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention Rewinding to an invalidated savepoint or to one of another arena is a checked runtime error.
+ * @attention Rewinding an arena obtained by Arena_load is a checked runtime error.
+ */
+extern void Arena_rewind(struct Arena *self, struct ArenaMark mark)
+__attribute__((__nonnull__(1)));
+
 /**
  * Clears the content of the arena (without releasing memory).
+ * Only arenas using ARENA_ZERO_ON_CLEAR touch the used memory, for the others this is O(1).
+ * Growable arenas rewind to their first block keeping the others for reuse.
  * All references obtained by calling Arena_allocate before calling
- * this function are invalidated.
+ * this function are invalidated, as are all the savepoints.
  * 
  * @attention (NULL == self) is a checked runtime error.
+ * @attention Clearing an arena obtained by Arena_load is a checked runtime error.
  */
 extern void Arena_clear(struct Arena *self)
 __attribute__((__nonnull__(1)));
@@ -110,7 +683,7 @@ extern void Arena_drop(struct Arena *self)
 __attribute__((__nonnull__(1)));
 
 /**
- * Gets the size of the biggest segment of memory currently available.
+ * Gets the amount of memory currently available across all the blocks of the arena.
  * 
  * @attention (NULL == self) is a checked runtime error.
  */
@@ -118,7 +691,7 @@ extern size_t Arena_available(const struct Arena *self)
 __attribute__((__warn_unused_result__, __nonnull__(1)));
 
 /**
- * Gets the capacity of the arena.
+ * Gets the capacity of the arena (the sum of the capacities of its blocks).
  * 
  * @attention (NULL == self) is a checked runtime error.
  */
@@ -127,12 +700,120 @@ __attribute__((__warn_unused_result__, __nonnull__(1)));
 
 /**
  * Gets the size of the memory currently in use by the arena (including slop memory).
+ * The unused tail of every block left behind by a growable arena counts as slop memory.
  * 
  * @attention (NULL == self) is a checked runtime error.
  */
 extern size_t Arena_size(const struct Arena *self)
 __attribute__((__warn_unused_result__, __nonnull__(1)));
 
+/**
+ * Creates a new reservoir of blocks of the specified capacity that keeps at most maxIdle idle blocks.
+ *
+ * @attention (blockCapacity < ARENA_MIN_CAPACITY) is a checked runtime error.
+ * @attention (0 == maxIdle) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern struct ArenaReservoir *ArenaReservoir_new(size_t blockCapacity, size_t maxIdle)
+__attribute__((__warn_unused_result__));
+
+/**
+ * Gets the number of idle blocks currently kept by the reservoir.
+ * This function is thread-safe, the result may be outdated as soon as it is returned.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern size_t ArenaReservoir_idle(const struct ArenaReservoir *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Drops the reservoir and all its idle blocks.
+ * All the arenas using the reservoir must have been dropped before calling this function.
+ *
+ * After calling this method self is invalidated.
+ *
+ * @attention this function is not thread-safe, no other thread may use the reservoir meanwhile.
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern void ArenaReservoir_drop(struct ArenaReservoir *self)
+__attribute__((__nonnull__(1)));
+
+#if ARENA_STATS_SUPPORT
+
+/**
+ * Gets the allocation statistics of the arena.
+ * 
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern struct ArenaStats Arena_stats(const struct Arena *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+#endif
+
+#if ARENA_PROFILE_SUPPORT
+
+/**
+ * Same as Arena_allocate, recording the allocation under site (usually __TRACE__), see Arena_allocateTraced.
+ * Sites are told apart by address, so site must be a string literal or outlive the arena.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == site) is a checked runtime error.
+ * @attention Invalid alignment values are checked runtime errors.
+ * @attention (0 == size) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error (unless the arena is growable).
+ */
+extern void *Arena_allocateAt(struct Arena *self, size_t alignment, size_t size, const char *site)
+__attribute__((__warn_unused_result__, __nonnull__(1, 4), __alloc_size__(3)));
+
+/**
+ * Same as Arena_clone, recording the allocation under site (usually __TRACE__), see Arena_cloneTraced.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == data) is a checked runtime error.
+ * @attention (NULL == site) is a checked runtime error.
+ * @attention Invalid alignment values are checked runtime errors.
+ * @attention (0 == size) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern void *Arena_cloneAt(struct Arena *self, const void *data, size_t alignment, size_t size, const char *site)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2, 5), __alloc_size__(4)));
+
+/**
+ * Copies into sites the (at most count) call sites that requested the most bytes from the arena, in decreasing order,
+ * returning how many were copied. Sites accumulate since the creation of the arena, clearing does not reset them;
+ * allocations not made through the traced macros are not profiled.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == sites) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern size_t Arena_sites(const struct Arena *self, struct ArenaSite *sites, size_t count)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2)));
+
+/**
+ * Prints the (at most count) call sites that requested the most bytes from the arena as a table to stream.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == stream) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern void Arena_dumpSites(const struct Arena *self, FILE *stream, size_t count)
+__attribute__((__nonnull__(1, 2)));
+
+/**
+ * Writes every call site of the arena to stream in the folded stacks format ("name;file:line bytes" per line)
+ * understood by flame graph tools, name being the root frame and bytes counting the padding too.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == name) is a checked runtime error.
+ * @attention (NULL == stream) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern void Arena_dumpFolded(const struct Arena *self, const char *name, FILE *stream)
+__attribute__((__nonnull__(1, 2, 3)));
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,155 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Davide Di Carlo
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#if __cplusplus < 201703L
+#error "arena.hpp requires C++17"
+#endif
+
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "arena.h"
+
+namespace arena {
+
+/**
+ * A std::pmr::memory_resource drawing memory from an arena.
+ * Deallocation is a no-op, memory is released by clearing or dropping the arena.
+ * The resource does not own the arena.
+ */
+class Resource final : public std::pmr::memory_resource {
+public:
+    explicit Resource(struct Arena *const arena) noexcept: arena(arena) {}
+
+    struct Arena *get() const noexcept {
+        return arena;
+    }
+
+private:
+    struct Arena *arena;
+
+    void *do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+        if (alignment > ARENA_MAX_ALIGNMENT) {
+            throw std::bad_alloc();
+        }
+
+        return Arena_allocate(arena, alignment, bytes > 0u ? bytes : 1u);
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        const auto resource = dynamic_cast<const Resource *>(&other);
+        return nullptr != resource && resource->arena == arena;
+    }
+};
+
+/**
+ * A standard allocator drawing memory from an arena.
+ * Deallocation is a no-op, memory is released by clearing or dropping the arena.
+ */
+template<typename T>
+class Allocator {
+public:
+    using value_type = T;
+
+    explicit Allocator(struct Arena *const arena) noexcept: arena(arena) {}
+
+    template<typename U>
+    Allocator(const Allocator<U> &other) noexcept: arena(other.get()) {}
+
+    T *allocate(const std::size_t n) {
+        static_assert(alignof(T) <= ARENA_MAX_ALIGNMENT, "Unsupported alignment");
+
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        return static_cast<T *>(Arena_allocate(arena, alignof(T), n > 0u ? n * sizeof(T) : 1u));
+    }
+
+    void deallocate(T *, std::size_t) noexcept {}
+
+    struct Arena *get() const noexcept {
+        return arena;
+    }
+
+    template<typename U>
+    bool operator==(const Allocator<U> &other) const noexcept {
+        return arena == other.get();
+    }
+
+    template<typename U>
+    bool operator!=(const Allocator<U> &other) const noexcept {
+        return arena != other.get();
+    }
+
+private:
+    struct Arena *arena;
+};
+
+/**
+ * Constructs an object of type T in the arena forwarding args to its constructor.
+ * The destructor of the object is never run by the arena.
+ */
+template<typename T, typename... Args>
+T *make(struct Arena *const arena, Args &&... args) {
+    static_assert(alignof(T) <= ARENA_MAX_ALIGNMENT, "Unsupported alignment");
+    return new(Arena_allocate(arena, alignof(T), sizeof(T))) T(std::forward<Args>(args)...);
+}
+
+/**
+ * Constructs an array of n value-initialized objects of type T in the arena.
+ * The destructors of the objects are never run by the arena.
+ *
+ * @attention (0 == n) is a checked runtime error.
+ * @throws std::bad_array_new_length if n * sizeof(T) overflows.
+ */
+template<typename T>
+T *make_array(struct Arena *const arena, const std::size_t n) {
+    static_assert(alignof(T) <= ARENA_MAX_ALIGNMENT, "Unsupported alignment");
+    static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
+
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+        throw std::bad_array_new_length();
+    }
+
+    T *const objects = static_cast<T *>(Arena_allocate(arena, alignof(T), n * sizeof(T)));
+
+    for (std::size_t i = 0u; i < n; i++) {
+        new(&objects[i]) T();
+    }
+
+    return objects;
+}
+
+}
@@ -0,0 +1,129 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Davide Di Carlo
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "arena.h"
+
+/*
+ * Functions shared by the modules of the library, not part of its public interface.
+ */
+
+// Taken from Bit Twiddling Hacks: http://graphics.stanford.edu/~seander/bithacks.html#DetermineIfPowerOf2
+#define __isPowerOfTwo(n)   (n && !(n & (n - 1u)))
+
+static inline __attribute__((__warn_unused_result__))
+size_t max(const size_t a, const size_t b) {
+    return a > b ? a : b;
+}
+
+static inline __attribute__((__warn_unused_result__))
+size_t min(const size_t a, const size_t b) {
+    return a < b ? a : b;
+}
+
+static inline __attribute__((__warn_unused_result__))
+bool isPowerOf2(const size_t n) {
+    return __isPowerOfTwo(n);
+}
+
+static inline __attribute__((__warn_unused_result__))
+size_t roundUp(const size_t n, const size_t alignment) {
+    assert(isPowerOf2(alignment));
+    return (n + alignment - 1u) & ~(alignment - 1u);
+}
+
+/**
+ * Marks the arena as owned by one of the wrappers of the library (ArenaPool, FrameArena, ThreadArena),
+ * which take care of dropping it; owned arenas cannot be adopted by other arenas, see Arena_adopt.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern void Arena_setOwned(struct Arena *self)
+__attribute__((__nonnull__(1)));
+
+
+/**
+ * A slot of a lock-free set of idle items, such as the arenas of ArenaPool or the blocks of ArenaReservoir.
+ * Threads start looking for items from a slot of their own so that they rarely contend for the same slots.
+ */
+struct Slot {
+    // every slot lives on its own cache line to avoid false sharing between threads
+    alignas(ARENA_CACHE_LINE)
+    _Atomic(void *) item;
+};
+
+/**
+ * Empties length slots.
+ *
+ * @attention (NULL == slots) is a checked runtime error.
+ */
+extern void Slots_init(struct Slot *slots, size_t length)
+__attribute__((__nonnull__(1)));
+
+/**
+ * Takes an item out of length slots, returning NULL if they are all empty.
+ * This function is thread-safe.
+ *
+ * @attention (NULL == slots) is a checked runtime error.
+ * @attention (0 == length) is a checked runtime error.
+ */
+extern void *Slots_take(struct Slot *slots, size_t length)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Puts item into an empty slot out of length slots, returning false if they are all full.
+ * This function is thread-safe.
+ *
+ * @attention (NULL == slots) is a checked runtime error.
+ * @attention (NULL == item) is a checked runtime error.
+ * @attention (0 == length) is a checked runtime error.
+ */
+extern bool Slots_give(struct Slot *slots, size_t length, void *item)
+__attribute__((__warn_unused_result__, __nonnull__(1, 3)));
+
+/**
+ * Takes the item out of slot, returning NULL if it is empty.
+ * This function is thread-safe.
+ *
+ * @attention (NULL == slot) is a checked runtime error.
+ */
+extern void *Slot_take(struct Slot *slot)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Counts the items held by length slots, the result is only a snapshot if other threads use them.
+ *
+ * @attention (NULL == slots) is a checked runtime error.
+ */
+extern size_t Slots_count(const struct Slot *slots, size_t length)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
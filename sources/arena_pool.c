@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <panic/panic.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <assert.h>
+#include "arena_pool.h"
+#include "arena_internal.h"
+
+struct ArenaPool {
+    alignas(ARENA_CACHE_LINE)
+    struct ArenaConfig config;
+    size_t length;
+#ifndef NDEBUG
+    atomic_size_t acquired;
+#endif
+    struct Slot slots[];
+};
+
+struct ArenaPool *ArenaPool_new(const struct ArenaConfig *const config, const size_t maxIdle) {
+    assert(NULL != config);
+    assert(maxIdle > 0u);
+
+    if (maxIdle > (SIZE_MAX - sizeof(struct ArenaPool)) / sizeof(struct Slot)) {
+        panic("Out of memory");
+    }
+
+    struct ArenaPool *const self = aligned_alloc(ARENA_CACHE_LINE, sizeof(*self) + maxIdle * sizeof(self->slots[0]));
+
+    if (NULL != self) {
+        self->config = *config;
+        self->length = maxIdle;
+#ifndef NDEBUG
+        atomic_init(&self->acquired, 0u);
+#endif
+
+        Slots_init(self->slots, maxIdle);
+
+        return self;
+    }
+
+    panic("Out of memory");
+}
+
+struct Arena *ArenaPool_acquire(struct ArenaPool *const self) {
+    assert(NULL != self);
+#ifndef NDEBUG
+    atomic_fetch_add_explicit(&self->acquired, 1u, memory_order_relaxed);
+#endif
+    struct Arena *arena = Slots_take(self->slots, self->length);
+
+    if (NULL == arena) {
+        arena = Arena_withConfig(&self->config);
+        Arena_setOwned(arena);
+    }
+
+    return arena;
+}
+
+void ArenaPool_release(struct ArenaPool *const self, struct Arena *const arena) {
+    assert(NULL != self);
+    assert(NULL != arena);
+#ifndef NDEBUG
+    const size_t acquired = atomic_fetch_sub_explicit(&self->acquired, 1u, memory_order_relaxed);
+    assert(acquired > 0u);
+#endif
+    Arena_clear(arena);
+
+    if (!Slots_give(self->slots, self->length, arena)) {
+        Arena_drop(arena);
+    }
+}
+
+size_t ArenaPool_trim(struct ArenaPool *const self, size_t keep) {
+    assert(NULL != self);
+    size_t dropped = 0u;
+
+    for (size_t i = 0u; i < self->length; i++) {
+        struct Slot *const slot = &self->slots[i];
+
+        if (NULL != atomic_load_explicit(&slot->item, memory_order_relaxed)) {
+            if (keep > 0u) {
+                keep -= 1u;
+            } else {
+                struct Arena *const arena = Slot_take(slot);
+
+                if (NULL != arena) {
+                    Arena_drop(arena);
+                    dropped += 1u;
+                }
+            }
+        }
+    }
+
+    return dropped;
+}
+
+size_t ArenaPool_idle(const struct ArenaPool *const self) {
+    assert(NULL != self);
+    return Slots_count(self->slots, self->length);
+}
+
+void ArenaPool_drop(struct ArenaPool *const self) {
+    assert(NULL != self);
+    assert(0u == atomic_load_explicit(&self->acquired, memory_order_relaxed));
+    ArenaPool_trim(self, 0u);
+    free(self);
+}
@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Davide Di Carlo
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "arena.h"
+
+/**
+ * A thread-safe pool recycling arenas of the same configuration.
+ * Idle arenas are kept in a bounded set of lock-free slots; every thread starts scanning
+ * from its own slot so that arenas tend to be reused by the thread that released them.
+ */
+struct ArenaPool;
+
+/**
+ * Creates a new pool of arenas created using config that keeps at most maxIdle idle arenas.
+ *
+ * @attention (NULL == config) is a checked runtime error.
+ * @attention (0 == maxIdle) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern struct ArenaPool *ArenaPool_new(const struct ArenaConfig *config, size_t maxIdle)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Takes an idle arena from the pool or creates a new one if there are none.
+ * This function is thread-safe.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern struct Arena *ArenaPool_acquire(struct ArenaPool *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Clears arena and gives it back to the pool, the arena is dropped if the pool is full.
+ * All references obtained from arena are invalidated.
+ * This function is thread-safe.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == arena) is a checked runtime error.
+ * @attention arena must have been acquired from self.
+ */
+extern void ArenaPool_release(struct ArenaPool *self, struct Arena *arena)
+__attribute__((__nonnull__(1, 2)));
+
+/**
+ * Drops idle arenas until at most keep of them are left, returning the number of dropped arenas.
+ * This function is thread-safe.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern size_t ArenaPool_trim(struct ArenaPool *self, size_t keep)
+__attribute__((__nonnull__(1)));
+
+/**
+ * Gets the number of idle arenas currently kept by the pool.
+ * This function is thread-safe, the result may be outdated as soon as it is returned.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern size_t ArenaPool_idle(const struct ArenaPool *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Drops the pool and all its idle arenas.
+ * All the acquired arenas must have been released before calling this function.
+ *
+ * After calling this method self is invalidated.
+ *
+ * @attention this function is not thread-safe, no other thread may use the pool meanwhile.
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern void ArenaPool_drop(struct ArenaPool *self)
+__attribute__((__nonnull__(1)));
+
+#ifdef __cplusplus
+}
+#endif
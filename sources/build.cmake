@@ -4,4 +4,22 @@ message("${ARCHIVE_NAME}@${CMAKE_CURRENT_LIST_DIR} using: ${CMAKE_CURRENT_LIST_F
 file(GLOB ARCHIVE_HEADERS ${CMAKE_CURRENT_LIST_DIR}/*.h)
 file(GLOB ARCHIVE_SOURCES ${CMAKE_CURRENT_LIST_DIR}/*.c)
 add_library(${ARCHIVE_NAME} ${ARCHIVE_HEADERS} ${ARCHIVE_SOURCES})
-target_link_libraries(${ARCHIVE_NAME} PRIVATE panic)
+find_package(Threads REQUIRED)
+target_link_libraries(${ARCHIVE_NAME} PRIVATE panic PUBLIC Threads::Threads)
+
+# Optional features
+option(ARENA_STATS_SUPPORT "Allocation statistics support" OFF)
+
+if (ARENA_STATS_SUPPORT)
+    target_compile_definitions(${ARCHIVE_NAME} PUBLIC ARENA_STATS_SUPPORT=1)
+else ()
+    target_compile_definitions(${ARCHIVE_NAME} PUBLIC ARENA_STATS_SUPPORT=0)
+endif (ARENA_STATS_SUPPORT)
+
+option(ARENA_PROFILE_SUPPORT "Allocation-site profiling support" OFF)
+
+if (ARENA_PROFILE_SUPPORT)
+    target_compile_definitions(${ARCHIVE_NAME} PUBLIC ARENA_PROFILE_SUPPORT=1)
+else ()
+    target_compile_definitions(${ARCHIVE_NAME} PUBLIC ARENA_PROFILE_SUPPORT=0)
+endif (ARENA_PROFILE_SUPPORT)
@@ -0,0 +1,206 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "compact.h"
+#include "arena_internal.h"
+
+#define RELOCATOR_MIN_CAPACITY  64u
+#define emptySlot               SIZE_MAX
+
+struct Relocation {
+    const char *object;
+    const struct ArenaType *type;
+    char *copy;
+};
+
+struct Relocator {
+    struct Arena *scratch;
+    struct Relocation *relocations;     // the reachable objects in breadth-first order
+    size_t *slots;                      // indexes of the relocations by object, twice as many as the relocations
+    size_t *links;                      // indexes of the relocations referenced by every field in traversal order
+    size_t length;
+    size_t capacity;
+    size_t linksLength;
+    size_t linksCapacity;
+};
+
+static size_t Relocator_visit(struct Relocator *self, const void *object, const struct ArenaType *type)
+__attribute__((__nonnull__(1, 2, 3)));
+
+static void Relocator_link(struct Relocator *self, size_t index)
+__attribute__((__nonnull__(1)));
+
+static void Relocator_grow(struct Relocator *self)
+__attribute__((__nonnull__(1)));
+
+static size_t *Relocator_probe(const struct Relocator *self, const void *object)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2)));
+
+static const void *loadPointer(const char *object, const struct ArenaField *field)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2)));
+
+struct Arena *Arena_compact(const struct ArenaType *const type, const void *const root, void **const compacted) {
+    assert(NULL != type);
+    assert(NULL != root);
+    assert(NULL != compacted);
+    struct Relocator self = {
+            .scratch = Arena_withConfig(&(struct ArenaConfig) {.growable = true, .zeroing = ARENA_ZERO_NEVER}),
+    };
+    size_t alignment = alignof(max_align_t);
+    size_t size = 0u;
+
+    // the relocations double as the queue of the traversal, the links spare a second lookup for the fixups
+    (void) Relocator_visit(&self, root, type);
+    for (size_t i = 0u; i < self.length; i++) {
+        const struct Relocation relocation = self.relocations[i];
+
+        for (size_t j = 0u; j < relocation.type->length; j++) {
+            const struct ArenaField *const field = &relocation.type->fields[j];
+            assert(field->offset + sizeof(void *) <= relocation.type->size);
+            const void *const pointer = loadPointer(relocation.object, field);
+            Relocator_link(&self, NULL == pointer ? emptySlot : Relocator_visit(&self, pointer, field->type));
+        }
+
+        alignment = max(alignment, relocation.type->alignment);
+        size = roundUp(size, relocation.type->alignment) + relocation.type->size;
+    }
+
+    // the memory of the arena is aligned to the strictest alignment, so the copies fit size exactly
+    struct Arena *const arena = Arena_withConfig(&(struct ArenaConfig) {
+            .capacity = size,
+            .alignment = alignment,
+            .zeroing = ARENA_ZERO_NEVER,
+    });
+
+    for (size_t i = 0u; i < self.length; i++) {
+        struct Relocation *const relocation = &self.relocations[i];
+        relocation->copy = Arena_allocate(arena, relocation->type->alignment, relocation->type->size);
+    }
+
+    for (size_t i = 0u, k = 0u; i < self.length; i++) {
+        const struct Relocation relocation = self.relocations[i];
+        memcpy(relocation.copy, relocation.object, relocation.type->size);
+
+        for (size_t j = 0u; j < relocation.type->length; j++, k++) {
+            if (emptySlot != self.links[k]) {
+                const void *const copy = self.relocations[self.links[k]].copy;
+                memcpy(relocation.copy + relocation.type->fields[j].offset, &copy, sizeof(copy));
+            }
+        }
+    }
+
+    *compacted = self.relocations[0].copy;
+    Arena_drop(self.scratch);
+    return arena;
+}
+
+size_t Relocator_visit(struct Relocator *const self, const void *const object, const struct ArenaType *const type) {
+    assert(NULL != self);
+    assert(NULL != object);
+    assert(NULL != type);
+
+    if (self->length >= self->capacity) {
+        Relocator_grow(self);
+    }
+
+    size_t *const slot = Relocator_probe(self, object);
+
+    if (emptySlot != *slot) {
+        assert(type == self->relocations[*slot].type);
+        return *slot;
+    }
+
+    assert(isPowerOf2(type->alignment) && type->alignment <= ARENA_MAX_ALIGNMENT);
+    assert(type->size > 0u);
+    assert(0u == type->length || NULL != type->fields);
+    *slot = self->length;
+    self->relocations[self->length] = (struct Relocation) {.object = object, .type = type};
+    return self->length++;
+}
+
+void Relocator_link(struct Relocator *const self, const size_t index) {
+    assert(NULL != self);
+
+    if (self->linksLength >= self->linksCapacity) {
+        const size_t capacity = 0u == self->linksCapacity ? RELOCATOR_MIN_CAPACITY : self->linksCapacity * 2u;
+        self->links = 0u == self->linksCapacity
+                      ? Arena_makeArray(self->scratch, size_t, capacity)
+                      : Arena_resize(self->scratch, self->links, alignof(size_t),
+                                     self->linksCapacity * sizeof(*self->links), capacity * sizeof(*self->links), NULL);
+        self->linksCapacity = capacity;
+    }
+
+    self->links[self->linksLength++] = index;
+}
+
+void Relocator_grow(struct Relocator *const self) {
+    assert(NULL != self);
+    const size_t capacity = 0u == self->capacity ? RELOCATOR_MIN_CAPACITY : self->capacity * 2u;
+
+    self->relocations = 0u == self->capacity
+                        ? Arena_makeArray(self->scratch, struct Relocation, capacity)
+                        : Arena_resize(self->scratch, self->relocations, alignof(struct Relocation),
+                                       self->capacity * sizeof(*self->relocations),
+                                       capacity * sizeof(*self->relocations), NULL);
+    self->slots = Arena_makeArray(self->scratch, size_t, capacity * 2u);
+    self->capacity = capacity;
+    memset(self->slots, 0xff, capacity * 2u * sizeof(*self->slots));
+
+    for (size_t i = 0u; i < self->length; i++) {
+        *Relocator_probe(self, self->relocations[i].object) = i;
+    }
+}
+
+size_t *Relocator_probe(const struct Relocator *const self, const void *const object) {
+    assert(NULL != self);
+    assert(NULL != object);
+    const size_t mask = self->capacity * 2u - 1u;
+    uint64_t hash = (uint64_t) (uintptr_t) object * 0x9e3779b97f4a7c15u;
+    hash ^= hash >> 32u;
+
+    for (size_t i = (size_t) hash & mask;; i = (i + 1u) & mask) {
+        size_t *const slot = &self->slots[i];
+
+        if (emptySlot == *slot || object == self->relocations[*slot].object) {
+            return slot;
+        }
+    }
+}
+
+const void *loadPointer(const char *const object, const struct ArenaField *const field) {
+    assert(NULL != object);
+    assert(NULL != field);
+    assert(NULL != field->type);
+    const void *pointer;
+    memcpy(&pointer, object + field->offset, sizeof(pointer));
+    return pointer;
+}
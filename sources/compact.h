@@ -0,0 +1,80 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Davide Di Carlo
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "arena.h"
+
+struct ArenaType;
+
+/**
+ * A pointer field of a type: the pointer stored at offset references either NULL or the start of an object of type.
+ */
+struct ArenaField {
+    size_t offset;
+    const struct ArenaType *type;
+};
+
+/**
+ * Describes the layout of the objects of a graph for Arena_compact: their size, their alignment
+ * and the offsets of the pointer fields to follow, everything else is copied as it is.
+ * Self-referencing types can be described by declaring the type before its fields.
+ */
+struct ArenaType {
+    size_t alignment;
+    size_t size;
+    size_t length;
+    const struct ArenaField *fields;
+};
+
+/**
+ * Deep-copies the graph of objects reachable from root into a new arena holding exactly the copies,
+ * rewriting their pointer fields to reference the copies; the graph is left untouched, so the arenas
+ * it lives in can be dropped afterwards.
+ * The copies are laid out in breadth-first order, objects reached more than once are copied once
+ * and cycles are preserved.
+ *
+ * Returns the new arena, which must be dropped by the caller, and stores the copy of root in compacted.
+ *
+ * @attention (NULL == type) is a checked runtime error.
+ * @attention (NULL == root) is a checked runtime error.
+ * @attention (NULL == compacted) is a checked runtime error.
+ * @attention Invalid alignment values and (0 == size) in the reachable types are checked runtime errors.
+ * @attention Fields not fitting in the size of their type are checked runtime errors.
+ * @attention Reaching the same object through fields of different types is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern struct Arena *Arena_compact(const struct ArenaType *type, const void *root, void **compacted)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2, 3)));
+
+#ifdef __cplusplus
+}
+#endif
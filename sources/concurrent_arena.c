@@ -0,0 +1,128 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <panic/panic.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <memory.h>
+#include <assert.h>
+#include "concurrent_arena.h"
+#include "arena_internal.h"
+
+static_assert(__isPowerOfTwo(CONCURRENT_ARENA_CACHE_LINE), "CONCURRENT_ARENA_CACHE_LINE must be a power of 2");
+static_assert(CONCURRENT_ARENA_CACHE_LINE >= alignof(max_align_t), "CONCURRENT_ARENA_CACHE_LINE must be >= alignof(max_align_t)");
+
+#define maxAlignment ((size_t) ARENA_MAX_ALIGNMENT)
+
+struct ConcurrentArena {
+    // the offset lives on its own cache line so that bumping it does not invalidate the read-mostly fields
+    alignas(CONCURRENT_ARENA_CACHE_LINE)
+    atomic_size_t offset;
+    alignas(CONCURRENT_ARENA_CACHE_LINE)
+    size_t capacity;
+    alignas(CONCURRENT_ARENA_CACHE_LINE)
+    char memory[];
+};
+
+struct ConcurrentArena *ConcurrentArena_default(void) {
+    return ConcurrentArena_withCapacity(ARENA_DEFAULT_CAPACITY);
+}
+
+struct ConcurrentArena *ConcurrentArena_withCapacity(const size_t capacity) {
+    assert(capacity > 0u);
+    const size_t actualCapacity = roundUp(max(ARENA_MIN_CAPACITY, capacity), CONCURRENT_ARENA_CACHE_LINE);
+    struct ConcurrentArena *const self = aligned_alloc(CONCURRENT_ARENA_CACHE_LINE, sizeof(*self) + actualCapacity);
+
+    if (NULL != self) {
+        memset(self, 0u, sizeof(*self) + actualCapacity);
+        atomic_init(&self->offset, 0u);
+        self->capacity = actualCapacity;
+        return self;
+    }
+
+    panic("Out of memory");
+}
+
+void *ConcurrentArena_allocate(struct ConcurrentArena *const self, const size_t alignment, const size_t size) {
+    assert(NULL != self);
+    assert(alignment <= maxAlignment);
+    assert(isPowerOf2(alignment));
+    assert(size > 0u);
+    size_t offset = atomic_load_explicit(&self->offset, memory_order_relaxed);
+    size_t alignedOffset;
+
+    // the padding depends on the observed offset so it is recomputed on every failed exchange
+    do {
+        alignedOffset = roundUp((uintptr_t) &self->memory[offset], alignment) - (uintptr_t) self->memory;
+
+        if (alignedOffset > self->capacity || size > self->capacity - alignedOffset) {
+            panic("Out of memory");
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&self->offset, &offset, alignedOffset + size,
+                                                    memory_order_relaxed, memory_order_relaxed));
+
+    return &self->memory[alignedOffset];
+}
+
+void *ConcurrentArena_clone(struct ConcurrentArena *const self, const void *const data, const size_t alignment,
+                            const size_t size) {
+    assert(NULL != self);
+    assert(NULL != data);
+    assert(alignment <= maxAlignment);
+    assert(isPowerOf2(alignment));
+    assert(size > 0u);
+    return memcpy(ConcurrentArena_allocate(self, alignment, size), data, size);
+}
+
+void ConcurrentArena_clear(struct ConcurrentArena *const self) {
+    assert(NULL != self);
+    memset(self->memory, 0u, atomic_load_explicit(&self->offset, memory_order_relaxed));
+    atomic_store_explicit(&self->offset, 0u, memory_order_relaxed);
+}
+
+void ConcurrentArena_drop(struct ConcurrentArena *const self) {
+    assert(NULL != self);
+    free(self);
+}
+
+size_t ConcurrentArena_available(const struct ConcurrentArena *const self) {
+    assert(NULL != self);
+    return self->capacity - ConcurrentArena_size(self);
+}
+
+size_t ConcurrentArena_capacity(const struct ConcurrentArena *const self) {
+    assert(NULL != self);
+    return self->capacity;
+}
+
+size_t ConcurrentArena_size(const struct ConcurrentArena *const self) {
+    assert(NULL != self);
+    return atomic_load_explicit(&((struct ConcurrentArena *) self)->offset, memory_order_relaxed);
+}
@@ -0,0 +1,140 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Davide Di Carlo
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "arena.h"
+
+#if !defined(CONCURRENT_ARENA_CACHE_LINE)
+#define CONCURRENT_ARENA_CACHE_LINE ARENA_CACHE_LINE
+#endif
+
+/**
+ * A fixed capacity arena that can be shared by many threads without external locking.
+ * Allocations reserve space with a compare-and-swap on the offset, ranges handed out never overlap.
+ */
+struct ConcurrentArena;
+
+/**
+ * Creates a new concurrent arena with default capacity.
+ *
+ * @attention Out of memory is a checked runtime error.
+ */
+extern struct ConcurrentArena *ConcurrentArena_default(void)
+__attribute__((__warn_unused_result__));
+
+/**
+ * Creates a new concurrent arena with at least the specified capacity.
+ *
+ * @attention (0 == capacity) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern struct ConcurrentArena *ConcurrentArena_withCapacity(size_t capacity)
+__attribute__((__warn_unused_result__));
+
+/**
+ * Returns a block of allocated and zeroed memory of the specified size using the specified alignment.
+ * Any power of 2 up to ARENA_MAX_ALIGNMENT is a valid alignment.
+ * This function is thread-safe.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention Invalid alignment values are checked runtime errors.
+ * @attention (0 == size) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern void *ConcurrentArena_allocate(struct ConcurrentArena *self, size_t alignment, size_t size)
+__attribute__((__warn_unused_result__, __nonnull__(1), __alloc_size__(3)));
+
+/**
+ * Clones and returns the object pointed by data.
+ * This function is thread-safe.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == data) is a checked runtime error.
+ * @attention Invalid alignment values are checked runtime errors.
+ * @attention (0 == size) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern void *ConcurrentArena_clone(struct ConcurrentArena *self, const void *data, size_t alignment, size_t size)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2), __alloc_size__(4)));
+
+/**
+ * Clears the content of the arena (without releasing memory).
+ * All references obtained by calling ConcurrentArena_allocate before calling
+ * this function are invalidated.
+ *
+ * @attention this function is not thread-safe, no other thread may use the arena meanwhile.
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern void ConcurrentArena_clear(struct ConcurrentArena *self)
+__attribute__((__nonnull__(1)));
+
+/**
+ * Drops the arena releasing memory.
+ * All references obtained by calling ConcurrentArena_allocate before calling
+ * this function are invalidated.
+ *
+ * After calling this method self is invalidated.
+ *
+ * @attention this function is not thread-safe, no other thread may use the arena meanwhile.
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern void ConcurrentArena_drop(struct ConcurrentArena *self)
+__attribute__((__nonnull__(1)));
+
+/**
+ * Gets the amount of memory currently available.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern size_t ConcurrentArena_available(const struct ConcurrentArena *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Gets the capacity of the arena.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern size_t ConcurrentArena_capacity(const struct ConcurrentArena *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Gets the size of the memory currently in use by the arena (including slop memory).
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern size_t ConcurrentArena_size(const struct ConcurrentArena *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+#ifdef __cplusplus
+}
+#endif
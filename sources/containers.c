@@ -0,0 +1,406 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <panic/panic.h>
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <memory.h>
+#include <assert.h>
+#include "containers.h"
+#include "arena_internal.h"
+
+#define VECTOR_MIN_CAPACITY 8u
+#define STRING_MIN_CAPACITY 16u
+#define MAP_MIN_CAPACITY    16u
+#define INTERN_MIN_CAPACITY 64u
+
+static inline __attribute__((__warn_unused_result__))
+size_t multiply(const size_t a, const size_t b) {
+    if (0u != a && b > SIZE_MAX / a) {
+        panic("Out of memory");
+    }
+
+    return a * b;
+}
+
+static inline __attribute__((__warn_unused_result__))
+uint64_t rotate(const uint64_t n, const unsigned bits) {
+    return (n << bits) | (n >> (64u - bits));
+}
+
+static void ArenaString_reserve(struct ArenaString *self, size_t size)
+__attribute__((__nonnull__(1)));
+
+static void ArenaMap_grow(struct ArenaMap *self)
+__attribute__((__nonnull__(1)));
+
+static void ArenaInterner_grow(struct ArenaInterner *self)
+__attribute__((__nonnull__(1)));
+
+static struct ArenaInternEntry *ArenaInterner_probe(struct ArenaInternEntry *entries, size_t capacity, uint64_t hash,
+                                                    const char *string, size_t length)
+__attribute__((__warn_unused_result__, __nonnull__(1, 4)));
+
+static struct ArenaMapEntry *ArenaMap_probe(struct ArenaMapEntry *entries, size_t capacity, uint64_t hash,
+                                            const void *key, size_t keySize)
+__attribute__((__warn_unused_result__, __nonnull__(1, 4)));
+
+struct ArenaVector ArenaVector_new(struct Arena *const arena, const size_t alignment, const size_t elementSize) {
+    assert(NULL != arena);
+    assert(isPowerOf2(alignment));
+    assert(elementSize > 0u);
+    return (struct ArenaVector) {
+            .arena = arena,
+            .alignment = alignment,
+            .elementSize = elementSize,
+    };
+}
+
+void ArenaVector_reserve(struct ArenaVector *const self, const size_t capacity) {
+    assert(NULL != self);
+
+    if (capacity > self->capacity) {
+        const size_t size = multiply(capacity, self->elementSize);
+
+        if (NULL == self->data) {
+            self->data = Arena_allocate(self->arena, self->alignment, size);
+        } else {
+            const size_t oldSize = self->capacity * self->elementSize;
+            self->data = Arena_resize(self->arena, self->data, self->alignment, oldSize, size, NULL);
+        }
+
+        self->capacity = capacity;
+    }
+}
+
+void *ArenaVector_push(struct ArenaVector *const self) {
+    assert(NULL != self);
+
+    if (self->length == self->capacity) {
+        ArenaVector_reserve(self, max(VECTOR_MIN_CAPACITY, multiply(self->capacity, 2u)));
+    }
+
+    return &self->data[self->elementSize * self->length++];
+}
+
+void *ArenaVector_pop(struct ArenaVector *const self) {
+    assert(NULL != self);
+    assert(self->length > 0u);
+    return &self->data[self->elementSize * --self->length];
+}
+
+void *ArenaVector_at(const struct ArenaVector *const self, const size_t index) {
+    assert(NULL != self);
+    assert(index < self->length);
+    return &self->data[self->elementSize * index];
+}
+
+void ArenaVector_clear(struct ArenaVector *const self) {
+    assert(NULL != self);
+    self->length = 0u;
+}
+
+size_t ArenaVector_length(const struct ArenaVector *const self) {
+    assert(NULL != self);
+    return self->length;
+}
+
+struct ArenaString ArenaString_new(struct Arena *const arena) {
+    assert(NULL != arena);
+    return (struct ArenaString) {
+            .arena = arena,
+    };
+}
+
+void ArenaString_append(struct ArenaString *const self, const char *const data, const size_t size) {
+    assert(NULL != self);
+    assert(NULL != data);
+    ArenaString_reserve(self, size);
+    memcpy(&self->data[self->length], data, size);
+    self->length += size;
+    self->data[self->length] = '\0';
+}
+
+void ArenaString_appendFormat(struct ArenaString *const self, const char *const format, ...) {
+    assert(NULL != self);
+    assert(NULL != format);
+    va_list args, argsCopy;
+    va_start(args, format);
+    va_copy(argsCopy, args);
+    const int size = vsnprintf(NULL, 0u, format, argsCopy);
+    va_end(argsCopy);
+
+    if (size < 0) {
+        va_end(args);
+        panic("Invalid format: `%s`", format);
+    }
+
+    ArenaString_reserve(self, (size_t) size);
+    vsnprintf(&self->data[self->length], (size_t) size + 1u, format, args);
+    va_end(args);
+    self->length += (size_t) size;
+}
+
+const char *ArenaString_get(const struct ArenaString *const self) {
+    assert(NULL != self);
+    return NULL == self->data ? "" : self->data;
+}
+
+size_t ArenaString_length(const struct ArenaString *const self) {
+    assert(NULL != self);
+    return self->length;
+}
+
+void ArenaString_reserve(struct ArenaString *const self, const size_t size) {
+    assert(NULL != self);
+
+    if (size > SIZE_MAX - self->length - 1u) {
+        panic("Out of memory");
+    }
+
+    // the capacity accounts for the NUL terminator
+    const size_t required = self->length + size + 1u;
+
+    if (required > self->capacity) {
+        const size_t capacity = max(max(STRING_MIN_CAPACITY, required), multiply(self->capacity, 2u));
+
+        if (NULL == self->data) {
+            self->data = Arena_allocate(self->arena, 1u, capacity);
+        } else {
+            self->data = Arena_resize(self->arena, self->data, 1u, self->capacity, capacity, NULL);
+        }
+
+        self->capacity = capacity;
+    }
+}
+
+uint64_t ArenaMap_hash(const void *const data, size_t size) {
+    assert(NULL != data);
+    const uint64_t k1 = 0x9e3779b97f4a7c15u, k2 = 0xc2b2ae3d27d4eb4fu;
+    const unsigned char *bytes = data;
+    uint64_t hash = k1 ^ (size * k2);
+    uint64_t word;
+
+    for (; size >= sizeof(word); size -= sizeof(word), bytes += sizeof(word)) {
+        memcpy(&word, bytes, sizeof(word));
+        hash = rotate(hash ^ (word * k2), 31u) * k1;
+    }
+
+    if (size > 0u) {
+        word = 0u;
+        memcpy(&word, bytes, size);
+        hash = rotate(hash ^ (word * k2), 31u) * k1;
+    }
+
+    // final avalanche taken from MurmurHash3
+    hash ^= hash >> 33u;
+    hash *= 0xff51afd7ed558ccdu;
+    hash ^= hash >> 33u;
+    hash *= 0xc4ceb9fe1a85ec53u;
+    hash ^= hash >> 33u;
+    return hash;
+}
+
+struct ArenaMap ArenaMap_new(struct Arena *const arena) {
+    assert(NULL != arena);
+    return (struct ArenaMap) {
+            .arena = arena,
+    };
+}
+
+void ArenaMap_put(struct ArenaMap *const self, const void *const key, const size_t keySize, void *const value) {
+    assert(NULL != self);
+    assert(NULL != key);
+
+    // keep the load factor below 3/4
+    if (4u * (self->length + 1u) > 3u * self->capacity) {
+        ArenaMap_grow(self);
+    }
+
+    const uint64_t hash = ArenaMap_hash(key, keySize);
+    struct ArenaMapEntry *const entry = ArenaMap_probe(self->entries, self->capacity, hash, key, keySize);
+
+    if (NULL == entry->key) {
+        entry->hash = hash;
+        entry->key = keySize > 0u ? Arena_clone(self->arena, key, 1u, keySize) : "";
+        entry->keySize = keySize;
+        self->length += 1u;
+    }
+
+    entry->value = value;
+}
+
+void **ArenaMap_get(const struct ArenaMap *const self, const void *const key, const size_t keySize) {
+    assert(NULL != self);
+    assert(NULL != key);
+
+    if (0u == self->length) {
+        return NULL;
+    }
+
+    struct ArenaMapEntry *const entry = ArenaMap_probe(self->entries, self->capacity,
+                                                       ArenaMap_hash(key, keySize), key, keySize);
+    return NULL == entry->key ? NULL : &entry->value;
+}
+
+size_t ArenaMap_length(const struct ArenaMap *const self) {
+    assert(NULL != self);
+    return self->length;
+}
+
+void ArenaMap_grow(struct ArenaMap *const self) {
+    assert(NULL != self);
+    const size_t capacity = max(MAP_MIN_CAPACITY, multiply(self->capacity, 2u));
+    const size_t size = multiply(capacity, sizeof(*self->entries));
+    struct ArenaMapEntry *const entries = memset(Arena_allocate(self->arena, alignof(*entries), size), 0u, size);
+
+    for (size_t i = 0u; i < self->capacity; i++) {
+        const struct ArenaMapEntry *const entry = &self->entries[i];
+
+        if (NULL != entry->key) {
+            *ArenaMap_probe(entries, capacity, entry->hash, entry->key, entry->keySize) = *entry;
+        }
+    }
+
+    self->entries = entries;
+    self->capacity = capacity;
+}
+
+struct ArenaMapEntry *ArenaMap_probe(struct ArenaMapEntry *const entries, const size_t capacity, const uint64_t hash,
+                                     const void *const key, const size_t keySize) {
+    assert(NULL != entries);
+    assert(isPowerOf2(capacity));
+    assert(NULL != key);
+    const size_t mask = capacity - 1u;
+
+    for (size_t i = (size_t) hash & mask;; i = (i + 1u) & mask) {
+        struct ArenaMapEntry *const entry = &entries[i];
+
+        if (NULL == entry->key ||
+            (hash == entry->hash && keySize == entry->keySize && 0 == memcmp(key, entry->key, keySize))) {
+            return entry;
+        }
+    }
+}
+
+struct ArenaInterner ArenaInterner_new(struct Arena *const arena) {
+    assert(NULL != arena);
+    return (struct ArenaInterner) {
+            .arena = arena,
+    };
+}
+
+const char *ArenaInterner_intern(struct ArenaInterner *const self, const char *const string, const size_t length) {
+    assert(NULL != self);
+    assert(NULL != string);
+
+    // the copy accounts for the NUL terminator
+    if (length > SIZE_MAX - 1u) {
+        panic("Out of memory");
+    }
+
+    // keep the load factor below 1/2, probing sequences stay short on the hot lookup path
+    if (2u * (self->length + 1u) > self->capacity) {
+        ArenaInterner_grow(self);
+    }
+
+    const uint64_t hash = ArenaMap_hash(string, length);
+    struct ArenaInternEntry *const entry = ArenaInterner_probe(self->entries, self->capacity, hash, string, length);
+
+    if (NULL == entry->string) {
+        char *const copy = Arena_allocate(self->arena, 1u, length + 1u);
+        memcpy(copy, string, length);
+        copy[length] = '\0';
+        entry->hash = hash;
+        entry->string = copy;
+        entry->length = length;
+        self->length += 1u;
+    }
+
+    return entry->string;
+}
+
+const char *ArenaInterner_find(const struct ArenaInterner *const self, const char *const string, const size_t length) {
+    assert(NULL != self);
+    assert(NULL != string);
+
+    if (0u == self->length) {
+        return NULL;
+    }
+
+    return ArenaInterner_probe(self->entries, self->capacity, ArenaMap_hash(string, length), string, length)->string;
+}
+
+size_t ArenaInterner_length(const struct ArenaInterner *const self) {
+    assert(NULL != self);
+    return self->length;
+}
+
+void ArenaInterner_grow(struct ArenaInterner *const self) {
+    assert(NULL != self);
+    const size_t capacity = max(INTERN_MIN_CAPACITY, multiply(self->capacity, 2u));
+    const size_t size = multiply(capacity, sizeof(*self->entries));
+    struct ArenaInternEntry *const entries = memset(Arena_allocate(self->arena, alignof(*entries), size), 0u, size);
+    const size_t mask = capacity - 1u;
+
+    // interned strings are distinct, rehashing only needs an empty slot
+    for (size_t i = 0u; i < self->capacity; i++) {
+        const struct ArenaInternEntry *const entry = &self->entries[i];
+
+        if (NULL != entry->string) {
+            size_t j = (size_t) entry->hash & mask;
+
+            while (NULL != entries[j].string) {
+                j = (j + 1u) & mask;
+            }
+
+            entries[j] = *entry;
+        }
+    }
+
+    self->entries = entries;
+    self->capacity = capacity;
+}
+
+struct ArenaInternEntry *ArenaInterner_probe(struct ArenaInternEntry *const entries, const size_t capacity,
+                                             const uint64_t hash, const char *const string, const size_t length) {
+    assert(NULL != entries);
+    assert(isPowerOf2(capacity));
+    assert(NULL != string);
+    const size_t mask = capacity - 1u;
+
+    for (size_t i = (size_t) hash & mask;; i = (i + 1u) & mask) {
+        struct ArenaInternEntry *const entry = &entries[i];
+
+        if (NULL == entry->string ||
+            (hash == entry->hash && length == entry->length && 0 == memcmp(string, entry->string, length))) {
+            return entry;
+        }
+    }
+}
@@ -0,0 +1,316 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Davide Di Carlo
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+
+/**
+ * A dynamic array of fixed size elements whose storage is drawn from an arena.
+ * Elements are stored contiguously, the storage grows geometrically in place whenever
+ * it is the most recent allocation of the arena.
+ *
+ * @attention the members of this struct should not be modified directly.
+ */
+struct ArenaVector {
+    struct Arena *arena;
+    char *data;
+    size_t length;
+    size_t capacity;
+    size_t alignment;
+    size_t elementSize;
+};
+
+/**
+ * A growable NUL-terminated string whose storage is drawn from an arena.
+ *
+ * @attention the members of this struct should not be modified directly.
+ */
+struct ArenaString {
+    struct Arena *arena;
+    char *data;
+    size_t length;
+    size_t capacity;
+};
+
+/**
+ * A slot of ArenaMap.
+ *
+ * @attention this struct must be treated as opaque therefore its members should not be accessed directly.
+ */
+struct ArenaMapEntry {
+    uint64_t hash;
+    const void *key;
+    size_t keySize;
+    void *value;
+};
+
+/**
+ * A flat open-addressing (linear probing) hash map from byte strings to pointers
+ * whose keys and slots are drawn from an arena.
+ *
+ * @attention the members of this struct should not be modified directly.
+ */
+struct ArenaMap {
+    struct Arena *arena;
+    struct ArenaMapEntry *entries;
+    size_t length;
+    size_t capacity;
+};
+
+/**
+ * A slot of ArenaInterner.
+ *
+ * @attention this struct must be treated as opaque therefore its members should not be accessed directly.
+ */
+struct ArenaInternEntry {
+    uint64_t hash;
+    const char *string;
+    size_t length;
+};
+
+/**
+ * A set of strings each one stored once in an arena, backed by a flat open-addressing (linear probing) index
+ * drawn from the same arena. Interned strings never move: equal strings interned by the same table
+ * have the same address so they can be compared by pointer.
+ *
+ * @attention the members of this struct should not be modified directly.
+ */
+struct ArenaInterner {
+    struct Arena *arena;
+    struct ArenaInternEntry *entries;
+    size_t length;
+    size_t capacity;
+};
+
+/**
+ * Creates a new empty vector of elements of the specified size and alignment, no memory is allocated.
+ *
+ * @attention (NULL == arena) is a checked runtime error.
+ * @attention Invalid alignment values are checked runtime errors.
+ * @attention (0 == elementSize) is a checked runtime error.
+ */
+extern struct ArenaVector ArenaVector_new(struct Arena *arena, size_t alignment, size_t elementSize)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Creates a new empty vector of elements of type T.
+ */
+#define ArenaVector_of(arena, T) \
+    ArenaVector_new((arena), _Alignof(T), sizeof(T))
+
+/**
+ * Ensures the vector can hold at least capacity elements without growing.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern void ArenaVector_reserve(struct ArenaVector *self, size_t capacity)
+__attribute__((__nonnull__(1)));
+
+/**
+ * Appends a new element returning its address, the content of the element follows
+ * the zeroing policy of the arena.
+ * The returned address is invalidated by the next call that grows the vector.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern void *ArenaVector_push(struct ArenaVector *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Removes the last element returning its address, which stays valid until the next push.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (0 == ArenaVector_length(self)) is a checked runtime error.
+ */
+extern void *ArenaVector_pop(struct ArenaVector *self)
+__attribute__((__nonnull__(1)));
+
+/**
+ * Gets the address of the element at index.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (index >= ArenaVector_length(self)) is a checked runtime error.
+ */
+extern void *ArenaVector_at(const struct ArenaVector *self, size_t index)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Removes all the elements keeping the storage.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern void ArenaVector_clear(struct ArenaVector *self)
+__attribute__((__nonnull__(1)));
+
+/**
+ * Gets the number of elements of the vector.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern size_t ArenaVector_length(const struct ArenaVector *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Creates a new empty string, no memory is allocated.
+ *
+ * @attention (NULL == arena) is a checked runtime error.
+ */
+extern struct ArenaString ArenaString_new(struct Arena *arena)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Appends size bytes of data to the string.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == data) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern void ArenaString_append(struct ArenaString *self, const char *data, size_t size)
+__attribute__((__nonnull__(1, 2)));
+
+/**
+ * Appends the formatted output to the string.
+ * Takes printf-like arguments.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == format) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern void ArenaString_appendFormat(struct ArenaString *self, const char *format, ...)
+__attribute__((__nonnull__(1, 2), __format__(__printf__, 2, 3)));
+
+/**
+ * Gets the NUL-terminated content of the string.
+ * The returned address is invalidated by the next append.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern const char *ArenaString_get(const struct ArenaString *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Gets the length of the string (without the NUL terminator).
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern size_t ArenaString_length(const struct ArenaString *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Hashes size bytes of data.
+ *
+ * @attention (NULL == data) is a checked runtime error.
+ */
+extern uint64_t ArenaMap_hash(const void *data, size_t size)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Creates a new empty map, no memory is allocated.
+ *
+ * @attention (NULL == arena) is a checked runtime error.
+ */
+extern struct ArenaMap ArenaMap_new(struct Arena *arena)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Associates value to a copy of key (stored in the arena) replacing the previous value if any.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == key) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern void ArenaMap_put(struct ArenaMap *self, const void *key, size_t keySize, void *value)
+__attribute__((__nonnull__(1, 2)));
+
+/**
+ * Gets the address of the value associated to key or NULL if key is not in the map.
+ * The returned address is invalidated by the next put.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == key) is a checked runtime error.
+ */
+extern void **ArenaMap_get(const struct ArenaMap *self, const void *key, size_t keySize)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2)));
+
+/**
+ * Gets the number of entries of the map.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern size_t ArenaMap_length(const struct ArenaMap *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Creates a new empty intern table, no memory is allocated.
+ *
+ * @attention (NULL == arena) is a checked runtime error.
+ */
+extern struct ArenaInterner ArenaInterner_new(struct Arena *arena)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Gets the NUL-terminated interned copy of the length bytes of string, storing it in the arena
+ * if it was not interned yet. The returned address stays valid as long as the arena is not cleared.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == string) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern const char *ArenaInterner_intern(struct ArenaInterner *self, const char *string, size_t length)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2)));
+
+/**
+ * Gets the interned copy of the length bytes of string or NULL if it was never interned.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == string) is a checked runtime error.
+ */
+extern const char *ArenaInterner_find(const struct ArenaInterner *self, const char *string, size_t length)
+__attribute__((__warn_unused_result__, __nonnull__(1, 2)));
+
+/**
+ * Gets the number of distinct strings interned.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern size_t ArenaInterner_length(const struct ArenaInterner *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+#ifdef __cplusplus
+}
+#endif
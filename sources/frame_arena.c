@@ -0,0 +1,160 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <panic/panic.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "frame_arena.h"
+#include "arena_internal.h"
+
+// marks generations holding no frame, or one being recycled
+#define noFrame     UINT64_MAX
+
+struct Generation {
+    // every generation lives on its own cache lines to avoid false sharing between consumers
+    alignas(ARENA_CACHE_LINE)
+    _Atomic(uint64_t) frame;    // the frame whose memory the arena holds
+    atomic_size_t readers;      // consumers pinning the generation
+    struct Arena *arena;
+};
+
+struct FrameArena {
+    alignas(ARENA_CACHE_LINE)
+    _Atomic(uint64_t) frame;
+    size_t length;
+    struct Generation generations[];
+};
+
+struct FrameArena *FrameArena_new(const struct ArenaConfig *const config, const size_t frames) {
+    assert(NULL != config);
+    assert(frames >= 2u);
+
+    if (frames > (SIZE_MAX - sizeof(struct FrameArena)) / sizeof(struct Generation)) {
+        panic("Out of memory");
+    }
+
+    struct FrameArena *const self = aligned_alloc(ARENA_CACHE_LINE,
+                                                  sizeof(*self) + frames * sizeof(self->generations[0]));
+
+    if (NULL != self) {
+        atomic_init(&self->frame, 0u);
+        self->length = frames;
+
+        for (size_t i = 0u; i < frames; i++) {
+            struct Generation *const generation = &self->generations[i];
+            atomic_init(&generation->frame, 0u == i ? 0u : noFrame);
+            atomic_init(&generation->readers, 0u);
+            generation->arena = Arena_withConfig(config);
+            Arena_setOwned(generation->arena);
+        }
+
+        return self;
+    }
+
+    panic("Out of memory");
+}
+
+void *FrameArena_allocate(struct FrameArena *const self, const size_t alignment, const size_t size) {
+    assert(NULL != self);
+    return Arena_allocate(FrameArena_arena(self), alignment, size);
+}
+
+struct Arena *FrameArena_arena(struct FrameArena *const self) {
+    assert(NULL != self);
+    const uint64_t frame = atomic_load_explicit(&self->frame, memory_order_relaxed);
+    return self->generations[frame % self->length].arena;
+}
+
+uint64_t FrameArena_frame(const struct FrameArena *const self) {
+    assert(NULL != self);
+    return atomic_load_explicit(&((struct FrameArena *) self)->frame, memory_order_acquire);
+}
+
+bool FrameArena_advance(struct FrameArena *const self) {
+    assert(NULL != self);
+    const uint64_t frame = atomic_load_explicit(&self->frame, memory_order_relaxed) + 1u;
+    struct Generation *const generation = &self->generations[frame % self->length];
+
+    if (0u != atomic_load_explicit(&generation->readers, memory_order_relaxed)) {
+        return false;
+    }
+
+    // retire the generation before checking the readers again: a consumer either pinned it before
+    // and is seen here, or it pins it after and sees that the frame it wants is gone (seq_cst on both sides)
+    const uint64_t expired = atomic_exchange(&generation->frame, noFrame);
+
+    if (0u != atomic_load(&generation->readers)) {
+        atomic_store_explicit(&generation->frame, expired, memory_order_relaxed);
+        return false;
+    }
+
+    Arena_clear(generation->arena);
+    atomic_store_explicit(&generation->frame, frame, memory_order_relaxed);
+    // publishes the memory of the completed frames to the consumers
+    atomic_store_explicit(&self->frame, frame, memory_order_release);
+    return true;
+}
+
+bool FrameArena_acquire(struct FrameArena *const self, const uint64_t frame) {
+    assert(NULL != self);
+
+    if (frame >= atomic_load_explicit(&self->frame, memory_order_acquire)) {
+        return false;
+    }
+
+    struct Generation *const generation = &self->generations[frame % self->length];
+    atomic_fetch_add(&generation->readers, 1u);
+
+    if (frame != atomic_load(&generation->frame)) {
+        atomic_fetch_sub_explicit(&generation->readers, 1u, memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+void FrameArena_release(struct FrameArena *const self, const uint64_t frame) {
+    assert(NULL != self);
+    struct Generation *const generation = &self->generations[frame % self->length];
+    // the frame of the generation may briefly read noFrame while FrameArena_advance backs off, check the pin instead
+    assert(0u < atomic_load_explicit(&generation->readers, memory_order_relaxed));
+    // orders the reads of the consumer before the clear of the generation
+    atomic_fetch_sub_explicit(&generation->readers, 1u, memory_order_release);
+}
+
+void FrameArena_drop(struct FrameArena *const self) {
+    assert(NULL != self);
+
+    for (size_t i = 0u; i < self->length; i++) {
+        assert(0u == atomic_load_explicit(&self->generations[i].readers, memory_order_relaxed));
+        Arena_drop(self->generations[i].arena);
+    }
+
+    free(self);
+}
@@ -0,0 +1,138 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Davide Di Carlo
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+
+/**
+ * A multi-buffered allocator for pipelines processing data in frames.
+ * Every frame allocates from one of K rotating arenas (the generations), moving to the next frame
+ * clears only the generation that held the frame K - 1 frames before it.
+ * Memory allocated during frame n therefore stays valid until frame n + K begins.
+ *
+ * A single producer thread allocates and advances frames, while any number of consumer threads
+ * may read the frames it completed as long as they pin them by FrameArena_acquire:
+ * a pinned generation is never cleared.
+ */
+struct FrameArena;
+
+/**
+ * Creates a new frame arena rotating frames generations, each one an arena created using config.
+ * The current frame is 0.
+ *
+ * @attention (NULL == config) is a checked runtime error.
+ * @attention (frames < 2) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern struct FrameArena *FrameArena_new(const struct ArenaConfig *config, size_t frames)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Allocates from the generation of the current frame, see Arena_allocate.
+ *
+ * @attention this function is not thread-safe, only the producer may call it.
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention Invalid alignment values are checked runtime errors.
+ * @attention (0 == size) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error (unless the arenas are growable).
+ */
+extern void *FrameArena_allocate(struct FrameArena *self, size_t alignment, size_t size)
+__attribute__((__warn_unused_result__, __nonnull__(1), __alloc_size__(3)));
+
+/**
+ * Gets the arena of the current frame, e.g. to build containers on it.
+ * The arena is cleared by FrameArena_advance and must not be cleared nor dropped by the caller.
+ *
+ * @attention this function is not thread-safe, only the producer may call it.
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern struct Arena *FrameArena_arena(struct FrameArena *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Gets the number of the current frame, all the frames before it are complete.
+ * This function is thread-safe: a consumer observing frame n also observes every write
+ * the producer made to the memory of the frames before n.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern uint64_t FrameArena_frame(const struct FrameArena *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Moves to the next frame clearing the generation of the frame it expires.
+ * Returns false, leaving the current frame unchanged, if the expiring generation is pinned by a consumer.
+ * All references obtained during the expired frame are invalidated.
+ *
+ * @attention this function is not thread-safe, only the producer may call it.
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern bool FrameArena_advance(struct FrameArena *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Pins the generation of a completed frame so that its memory stays valid until FrameArena_release.
+ * Returns false if frame is not complete yet or has already expired.
+ * This function is thread-safe.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern bool FrameArena_acquire(struct FrameArena *self, uint64_t frame)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Unpins the generation of frame, references to its memory must not be used anymore.
+ * This function is thread-safe.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention frame must have been pinned by a successful call to FrameArena_acquire.
+ */
+extern void FrameArena_release(struct FrameArena *self, uint64_t frame)
+__attribute__((__nonnull__(1)));
+
+/**
+ * Drops the frame arena and all its generations.
+ *
+ * After calling this method self is invalidated.
+ *
+ * @attention this function is not thread-safe, no other thread may use the frame arena meanwhile.
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern void FrameArena_drop(struct FrameArena *self)
+__attribute__((__nonnull__(1)));
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,171 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdalign.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "object_pool.h"
+#include "arena_internal.h"
+
+static_assert(__isPowerOfTwo(SIZE_CLASS_POOL_MIN_SIZE), "SIZE_CLASS_POOL_MIN_SIZE must be a power of 2");
+static_assert(__isPowerOfTwo(SIZE_CLASS_POOL_MAX_SIZE), "SIZE_CLASS_POOL_MAX_SIZE must be a power of 2");
+static_assert(SIZE_CLASS_POOL_MIN_SIZE >= sizeof(void *), "SIZE_CLASS_POOL_MIN_SIZE must be >= sizeof(void *)");
+static_assert(SIZE_CLASS_POOL_MAX_SIZE >= SIZE_CLASS_POOL_MIN_SIZE, "SIZE_CLASS_POOL_MAX_SIZE must be >= SIZE_CLASS_POOL_MIN_SIZE");
+
+#define maxAlign    alignof(max_align_t)
+
+struct FreeObject {
+    struct FreeObject *next;
+};
+
+struct ObjectPool {
+    struct Arena *arena;
+    struct FreeObject *free;    // released objects
+    char *slab;                 // objects of the current slab never handed out
+    size_t remaining;           // number of objects left in the current slab
+    size_t stride;
+    size_t alignment;
+    size_t slabObjects;
+};
+
+#define SIZE_CLASSES    (__builtin_ctz(SIZE_CLASS_POOL_MAX_SIZE) - __builtin_ctz(SIZE_CLASS_POOL_MIN_SIZE) + 1)
+
+struct SizeClassPool {
+    struct Arena *arena;
+    struct ObjectPool classes[SIZE_CLASSES];
+};
+
+// the smallest class whose size is >= size
+static inline __attribute__((__warn_unused_result__))
+size_t SizeClassPool_classOf(const size_t size) {
+    assert(size > 0u && size <= SIZE_CLASS_POOL_MAX_SIZE);
+    if (size <= SIZE_CLASS_POOL_MIN_SIZE) {
+        return 0u;
+    }
+    return (size_t) (1 + __builtin_clzl(SIZE_CLASS_POOL_MIN_SIZE) - __builtin_clzl(size - 1u));
+}
+
+static void ObjectPool_init(struct ObjectPool *self, struct Arena *arena, size_t alignment, size_t size)
+__attribute__((__nonnull__(1, 2)));
+
+static void *ObjectPool_refill(struct ObjectPool *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+struct ObjectPool *ObjectPool_new(struct Arena *const arena, const size_t alignment, const size_t size) {
+    assert(NULL != arena);
+    assert(isPowerOf2(alignment));
+    assert(size > 0u);
+    struct ObjectPool *const self = Arena_allocate(arena, alignof(*self), sizeof(*self));
+    ObjectPool_init(self, arena, alignment, size);
+    return self;
+}
+
+void *ObjectPool_allocate(struct ObjectPool *const self) {
+    assert(NULL != self);
+    struct FreeObject *const object = self->free;
+
+    if (NULL != object) {
+        self->free = object->next;
+        return object;
+    }
+
+    if (self->remaining > 0u) {
+        void *const fresh = self->slab;
+        self->slab += self->stride;
+        self->remaining -= 1u;
+        return fresh;
+    }
+
+    return ObjectPool_refill(self);
+}
+
+void ObjectPool_release(struct ObjectPool *const self, void *const object) {
+    assert(NULL != self);
+    assert(NULL != object);
+    struct FreeObject *const freeObject = object;
+    freeObject->next = self->free;
+    self->free = freeObject;
+}
+
+struct SizeClassPool *SizeClassPool_new(struct Arena *const arena) {
+    assert(NULL != arena);
+    struct SizeClassPool *const self = Arena_allocate(arena, alignof(*self), sizeof(*self));
+    self->arena = arena;
+
+    for (size_t i = 0u; i < SIZE_CLASSES; i++) {
+        const size_t size = ((size_t) SIZE_CLASS_POOL_MIN_SIZE) << i;
+        ObjectPool_init(&self->classes[i], arena, min(size, maxAlign), size);
+    }
+
+    return self;
+}
+
+void *SizeClassPool_allocate(struct SizeClassPool *const self, const size_t size) {
+    assert(NULL != self);
+    assert(size > 0u);
+
+    if (size > SIZE_CLASS_POOL_MAX_SIZE) {
+        return Arena_allocate(self->arena, maxAlign, size);
+    }
+
+    return ObjectPool_allocate(&self->classes[SizeClassPool_classOf(size)]);
+}
+
+void SizeClassPool_release(struct SizeClassPool *const self, void *const object, const size_t size) {
+    assert(NULL != self);
+    assert(NULL != object);
+    assert(size > 0u);
+
+    if (size <= SIZE_CLASS_POOL_MAX_SIZE) {
+        ObjectPool_release(&self->classes[SizeClassPool_classOf(size)], object);
+    }
+}
+
+void ObjectPool_init(struct ObjectPool *const self, struct Arena *const arena, const size_t alignment,
+                     const size_t size) {
+    assert(NULL != self);
+    assert(NULL != arena);
+    // released objects hold the link of the free list
+    const size_t actualAlignment = max(alignment, alignof(struct FreeObject));
+    self->arena = arena;
+    self->free = NULL;
+    self->slab = NULL;
+    self->remaining = 0u;
+    self->stride = roundUp(max(size, sizeof(struct FreeObject)), actualAlignment);
+    self->alignment = actualAlignment;
+    self->slabObjects = max(1u, OBJECT_POOL_SLAB_SIZE / self->stride);
+}
+
+void *ObjectPool_refill(struct ObjectPool *const self) {
+    assert(NULL != self);
+    assert(0u == self->remaining);
+
+    char *const slab = Arena_allocateArray(self->arena, self->alignment, self->slabObjects, self->stride);
+    self->slab = slab + self->stride;
+    self->remaining = self->slabObjects - 1u;
+    return slab;
+}
@@ -0,0 +1,133 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Davide Di Carlo
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "arena.h"
+
+#if !defined(OBJECT_POOL_SLAB_SIZE)
+#define OBJECT_POOL_SLAB_SIZE       4096u
+#endif
+
+#if !defined(SIZE_CLASS_POOL_MIN_SIZE)
+#define SIZE_CLASS_POOL_MIN_SIZE    16u
+#endif
+
+#if !defined(SIZE_CLASS_POOL_MAX_SIZE)
+#define SIZE_CLASS_POOL_MAX_SIZE    2048u
+#endif
+
+/**
+ * A pool of fixed size objects carved in slabs out of an arena.
+ * Released objects are recycled through an intrusive free list, allocating and releasing are O(1).
+ * The pool itself and all its slabs live in the arena: clearing or dropping the arena releases everything at once.
+ */
+struct ObjectPool;
+
+/**
+ * A set of object pools, one per power of 2 size class between SIZE_CLASS_POOL_MIN_SIZE
+ * and SIZE_CLASS_POOL_MAX_SIZE; bigger objects are allocated straight from the arena and never recycled.
+ * The pools live in the arena: clearing or dropping the arena releases everything at once.
+ */
+struct SizeClassPool;
+
+/**
+ * Creates a new pool of objects of the specified size and alignment inside arena.
+ *
+ * @attention (NULL == arena) is a checked runtime error.
+ * @attention Invalid alignment values are checked runtime errors.
+ * @attention (0 == size) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern struct ObjectPool *ObjectPool_new(struct Arena *arena, size_t alignment, size_t size)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Creates a new pool of objects of type T inside arena.
+ */
+#define ObjectPool_of(arena, T) \
+    ObjectPool_new((arena), _Alignof(T), sizeof(T))
+
+/**
+ * Returns an object reusing a released one if any, the content of the object is unspecified.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error (unless the arena is growable).
+ */
+extern void *ObjectPool_allocate(struct ObjectPool *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Gives object back to the pool for reuse.
+ * All references to object are invalidated.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == object) is a checked runtime error.
+ * @attention object must have been allocated from self.
+ */
+extern void ObjectPool_release(struct ObjectPool *self, void *object)
+__attribute__((__nonnull__(1, 2)));
+
+/**
+ * Creates a new set of size class pools inside arena.
+ *
+ * @attention (NULL == arena) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern struct SizeClassPool *SizeClassPool_new(struct Arena *arena)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Returns an object of at least the specified size aligned to alignof(max_align_t)
+ * or to its size class, whichever is smaller.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (0 == size) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error (unless the arena is growable).
+ */
+extern void *SizeClassPool_allocate(struct SizeClassPool *self, size_t size)
+__attribute__((__warn_unused_result__, __nonnull__(1), __alloc_size__(2)));
+
+/**
+ * Gives object of the specified size back to its size class for reuse.
+ * All references to object are invalidated.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention (NULL == object) is a checked runtime error.
+ * @attention object must have been allocated from self with the same size.
+ */
+extern void SizeClassPool_release(struct SizeClassPool *self, void *object, size_t size)
+__attribute__((__nonnull__(1, 2)));
+
+#ifdef __cplusplus
+}
+#endif
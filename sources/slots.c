@@ -0,0 +1,116 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+#include "arena_internal.h"
+
+static atomic_size_t threadCounter = 0u;
+static _Thread_local size_t threadIndex = SIZE_MAX;
+
+static size_t startingSlot(size_t length)
+__attribute__((__warn_unused_result__));
+
+void Slots_init(struct Slot *const slots, const size_t length) {
+    assert(NULL != slots);
+
+    for (size_t i = 0u; i < length; i++) {
+        atomic_init(&slots[i].item, NULL);
+    }
+}
+
+void *Slots_take(struct Slot *const slots, const size_t length) {
+    assert(NULL != slots);
+    assert(length > 0u);
+    const size_t start = startingSlot(length);
+
+    for (size_t i = 0u; i < length; i++) {
+        void *const item = Slot_take(&slots[(start + i) % length]);
+
+        if (NULL != item) {
+            return item;
+        }
+    }
+
+    return NULL;
+}
+
+bool Slots_give(struct Slot *const slots, const size_t length, void *const item) {
+    assert(NULL != slots);
+    assert(NULL != item);
+    assert(length > 0u);
+    const size_t start = startingSlot(length);
+
+    for (size_t i = 0u; i < length; i++) {
+        struct Slot *const slot = &slots[(start + i) % length];
+        void *expected = NULL;
+
+        if (NULL == atomic_load_explicit(&slot->item, memory_order_relaxed) &&
+            atomic_compare_exchange_strong_explicit(&slot->item, &expected, item,
+                                                    memory_order_release, memory_order_relaxed)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void *Slot_take(struct Slot *const slot) {
+    assert(NULL != slot);
+
+    // a plain load first, so that empty slots are not written
+    if (NULL != atomic_load_explicit(&slot->item, memory_order_relaxed)) {
+        return atomic_exchange_explicit(&slot->item, NULL, memory_order_acquire);
+    }
+
+    return NULL;
+}
+
+size_t Slots_count(const struct Slot *const slots, const size_t length) {
+    assert(NULL != slots);
+    size_t count = 0u;
+
+    for (size_t i = 0u; i < length; i++) {
+        if (NULL != atomic_load_explicit(&((struct Slot *) slots)[i].item, memory_order_relaxed)) {
+            count += 1u;
+        }
+    }
+
+    return count;
+}
+
+size_t startingSlot(const size_t length) {
+    assert(length > 0u);
+
+    if (SIZE_MAX == threadIndex) {
+        threadIndex = atomic_fetch_add_explicit(&threadCounter, 1u, memory_order_relaxed);
+    }
+
+    return threadIndex % length;
+}
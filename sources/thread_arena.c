@@ -0,0 +1,96 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <panic/panic.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "thread_arena.h"
+#include "arena_internal.h"
+
+struct ThreadArena {
+    struct ArenaConfig config;
+    pthread_key_t key;          // the arena of every thread, dropped by the key destructor on exit
+};
+
+static void dropArena(void *arena);
+
+struct ThreadArena *ThreadArena_new(const struct ArenaConfig *const config) {
+    assert(NULL != config);
+    assert(NULL != config->reservoir);
+    assert(config->growable);
+    struct ThreadArena *const self = malloc(sizeof(*self));
+
+    if (NULL == self) {
+        panic("Out of memory");
+    }
+
+    if (0 != pthread_key_create(&self->key, dropArena)) {
+        panic("Unable to create the thread key");
+    }
+
+    self->config = *config;
+    return self;
+}
+
+struct Arena *ThreadArena_get(struct ThreadArena *const self) {
+    assert(NULL != self);
+    struct Arena *arena = pthread_getspecific(self->key);
+
+    if (NULL == arena) {
+        arena = Arena_withConfig(&self->config);
+        Arena_setOwned(arena);
+
+        if (0 != pthread_setspecific(self->key, arena)) {
+            panic("Out of memory");
+        }
+    }
+
+    return arena;
+}
+
+void *ThreadArena_allocate(struct ThreadArena *const self, const size_t alignment, const size_t size) {
+    assert(NULL != self);
+    return Arena_allocate(ThreadArena_get(self), alignment, size);
+}
+
+void ThreadArena_drop(struct ThreadArena *const self) {
+    assert(NULL != self);
+    struct Arena *const arena = pthread_getspecific(self->key);
+
+    if (NULL != arena) {
+        Arena_drop(arena);
+    }
+
+    pthread_key_delete(self->key);
+    free(self);
+}
+
+void dropArena(void *const arena) {
+    assert(NULL != arena);
+    Arena_drop(arena);
+}
@@ -0,0 +1,91 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Davide Di Carlo
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "arena.h"
+
+/**
+ * Gives every thread an arena of its own, so that allocating takes no synchronization at all.
+ * The arenas take their blocks from the shared reservoir of their configuration and give them back
+ * when they are cleared and when their thread exits.
+ */
+struct ThreadArena;
+
+/**
+ * Creates a new set of thread arenas, each one created using config on first use.
+ *
+ * @attention (NULL == config) is a checked runtime error.
+ * @attention (NULL == config->reservoir) is a checked runtime error.
+ * @attention (!config->growable) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern struct ThreadArena *ThreadArena_new(const struct ArenaConfig *config)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Gets the arena of the calling thread, creating it if needed.
+ * The arena is dropped when the thread exits, it may be cleared but must not be dropped by the caller;
+ * threads may keep the returned address to skip the lookup on the hot path.
+ * This function is thread-safe.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern struct Arena *ThreadArena_get(struct ThreadArena *self)
+__attribute__((__warn_unused_result__, __nonnull__(1)));
+
+/**
+ * Allocates from the arena of the calling thread, see Arena_allocate.
+ * This function is thread-safe.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ * @attention Invalid alignment values are checked runtime errors.
+ * @attention (0 == size) is a checked runtime error.
+ * @attention Out of memory is a checked runtime error.
+ */
+extern void *ThreadArena_allocate(struct ThreadArena *self, size_t alignment, size_t size)
+__attribute__((__warn_unused_result__, __nonnull__(1), __alloc_size__(3)));
+
+/**
+ * Drops the set of thread arenas along with the arena of the calling thread.
+ * Every other thread that used it must have exited, the reservoir is not dropped.
+ *
+ * After calling this method self is invalidated.
+ *
+ * @attention (NULL == self) is a checked runtime error.
+ */
+extern void ThreadArena_drop(struct ThreadArena *self)
+__attribute__((__nonnull__(1)));
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,150 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <arena.h>
+#include <arena_pool.h>
+#include "test.h"
+
+#define LENGTH      4096u
+
+static struct Arena *newArena(void);
+
+static char *fill(struct Arena *arena, char value);
+
+static bool isFilled(const char *memory, char value);
+
+static void checkAborts(void (*action)(void));
+
+static void adoptTwice(void);
+
+static void adoptIntoAdopted(void);
+
+static void adoptPooled(void);
+
+int main() {
+    struct Arena *const consumer = newArena();
+    const size_t size = Arena_size(consumer);
+
+    // memory of the adopted arenas stays valid and is not counted by the consumer
+    struct Arena *const first = newArena();
+    const char *const kept = fill(first, 'a');
+    Arena_adopt(consumer, first);
+    Test_check(size == Arena_size(consumer));
+    Test_check(isFilled(kept, 'a'));
+
+    // rewinding releases the arenas adopted after the savepoint only
+    const struct ArenaMark mark = Arena_mark(consumer);
+    struct Arena *const second = newArena();
+    const char *const released = fill(second, 'b');
+    Arena_adopt(consumer, second);
+    Test_check(isFilled(released, 'b'));
+    Arena_rewind(consumer, mark);
+    Test_check(isFilled(kept, 'a'));
+
+    // an arena adopting others can still be adopted
+    struct Arena *const parent = newArena();
+    struct Arena *const child = newArena();
+    const char *const nested = fill(child, 'c');
+    Arena_adopt(parent, child);
+    Arena_adopt(consumer, parent);
+    Test_check(isFilled(nested, 'c'));
+
+    Arena_clear(consumer);
+    Test_check(0u == Arena_size(consumer));
+    Arena_adopt(consumer, newArena());
+    Arena_drop(consumer);
+
+    checkAborts(adoptTwice);
+    checkAborts(adoptIntoAdopted);
+    checkAborts(adoptPooled);
+    return 0;
+}
+
+struct Arena *newArena(void) {
+    return Arena_withConfig(&(struct ArenaConfig) {.capacity = 1024u, .growable = true});
+}
+
+// spans several blocks, so that every block of the adopted arena is checked
+char *fill(struct Arena *const arena, const char value) {
+    char *const memory = Arena_allocate(arena, 1u, LENGTH);
+    memset(memory, value, LENGTH);
+    return memory;
+}
+
+bool isFilled(const char *const memory, const char value) {
+    for (size_t i = 0u; i < LENGTH; i++) {
+        if (value != memory[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// checked runtime errors only abort if NDEBUG is not defined
+void checkAborts(void (*const action)(void)) {
+#if defined(NDEBUG)
+    (void) action;
+#else
+    const pid_t child = fork();
+    Test_check(child >= 0);
+
+    if (0 == child) {
+        action();
+        _exit(EXIT_SUCCESS);
+    }
+
+    int status = 0;
+    Test_check(child == waitpid(child, &status, 0));
+    Test_check(WIFSIGNALED(status) && SIGABRT == WTERMSIG(status));
+#endif
+}
+
+// dropping both parents would release the source twice
+void adoptTwice(void) {
+    struct Arena *const source = newArena();
+    Arena_adopt(newArena(), source);
+    Arena_adopt(newArena(), source);
+}
+
+// adopting into an adopted arena lets two arenas adopt each other
+void adoptIntoAdopted(void) {
+    struct Arena *const first = newArena();
+    struct Arena *const second = newArena();
+    Arena_adopt(first, second);
+    Arena_adopt(second, first);
+}
+
+// the pool would hand out an arena released by its adopter
+void adoptPooled(void) {
+    struct ArenaPool *const pool = ArenaPool_new(&(struct ArenaConfig) {.capacity = 1024u}, 1u);
+    Arena_adopt(newArena(), ArenaPool_acquire(pool));
+}
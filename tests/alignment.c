@@ -0,0 +1,126 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdalign.h>
+#include <stdint.h>
+#include <arena.h>
+#include "test.h"
+
+#define ROUNDS      64u
+
+static char buffer[64u * 1024u];
+
+static void checkAlignments(struct Arena *arena);
+
+static void checkPadding(struct Arena *arena);
+
+static void checkBaseAlignment(struct Arena *arena, size_t alignment, size_t blockCapacity);
+
+int main() {
+    struct Arena *arena = Arena_withCapacity(ROUNDS * 2u * ARENA_MAX_ALIGNMENT);
+    checkAlignments(arena);
+    Arena_clear(arena);
+    checkPadding(arena);
+    Arena_drop(arena);
+
+    arena = Arena_withConfig(&(struct ArenaConfig) {.capacity = 1024u, .growable = true});
+    checkAlignments(arena);
+    Arena_clear(arena);
+    checkPadding(arena);
+    Arena_drop(arena);
+
+    arena = Arena_withConfig(&(struct ArenaConfig) {.backend = ARENA_BACKEND_VIRTUAL, .capacity = 64u * 1024u * 1024u});
+    checkAlignments(arena);
+    Arena_clear(arena);
+    checkPadding(arena);
+    Arena_drop(arena);
+
+    // the buffer is deliberately misaligned and the arena spills to the heap once it is exhausted
+    arena = Arena_fromBuffer(&buffer[1], sizeof(buffer) - 1u, &(struct ArenaConfig) {.growable = true});
+    checkAlignments(arena);
+    Arena_clear(arena);
+    checkPadding(arena);
+    Arena_drop(arena);
+
+    // base alignments stricter than max_align_t hold for every block
+    const size_t alignment = 4u * alignof(max_align_t);
+    arena = Arena_withConfig(&(struct ArenaConfig) {
+            .capacity = 1024u, .maxBlockCapacity = 1024u, .growable = true, .alignment = alignment,
+    });
+    checkBaseAlignment(arena, alignment, 1024u);
+    checkAlignments(arena);
+    Arena_drop(arena);
+
+    arena = Arena_fromBuffer(&buffer[1], sizeof(buffer) - 1u, &(struct ArenaConfig) {
+            .maxBlockCapacity = 1024u, .growable = true, .alignment = ARENA_MAX_ALIGNMENT,
+    });
+    Test_check(0u == (uintptr_t) Arena_allocate(arena, 1u, 1u) % ARENA_MAX_ALIGNMENT);
+    Arena_drop(arena);
+
+    arena = Arena_withConfig(&(struct ArenaConfig) {
+            .backend = ARENA_BACKEND_VIRTUAL, .capacity = 1024u * 1024u, .alignment = ARENA_MAX_ALIGNMENT,
+    });
+    Test_check(0u == (uintptr_t) Arena_allocate(arena, 1u, 1u) % ARENA_MAX_ALIGNMENT);
+    Arena_drop(arena);
+    return 0;
+}
+
+// every power of 2 up to ARENA_MAX_ALIGNMENT, interleaved with odd sizes so that padding is needed
+void checkAlignments(struct Arena *const arena) {
+    for (size_t i = 0u; i < ROUNDS; i++) {
+        for (size_t alignment = 1u; alignment <= ARENA_MAX_ALIGNMENT; alignment *= 2u) {
+            const size_t size = 1u + (i * 7u + alignment) % 13u;
+            char *const memory = Arena_allocate(arena, alignment, size);
+            Test_check(0u == (uintptr_t) memory % alignment);
+            memset(memory, 0xa5, size);
+        }
+    }
+}
+
+// the padding taken by an allocation counts in Arena_size
+void checkPadding(struct Arena *const arena) {
+    Test_check(0u == Arena_size(arena));
+    const char *const first = Arena_allocate(arena, 1u, 1u);
+    Test_check(1u == Arena_size(arena));
+
+    for (size_t alignment = 2u; alignment <= 64u; alignment *= 2u) {
+        const size_t before = Arena_size(arena);
+        const char *const top = first + before;
+        const char *const memory = Arena_allocate(arena, alignment, 3u);
+        const size_t padding = (size_t) (memory - top);
+        Test_check(padding < alignment);
+        Test_check(padding == (size_t) ((0u - (uintptr_t) top) & (alignment - 1u)));
+        Test_check(before + padding + 3u == Arena_size(arena));
+    }
+}
+
+// allocations filling a whole block start at the beginning of a new one
+void checkBaseAlignment(struct Arena *const arena, const size_t alignment, const size_t blockCapacity) {
+    for (size_t i = 0u; i < ROUNDS; i++) {
+        Test_check(0u == (uintptr_t) Arena_allocate(arena, 1u, blockCapacity) % alignment);
+    }
+}
@@ -0,0 +1,14 @@
+message("tests@${CMAKE_CURRENT_LIST_DIR} using: ${CMAKE_CURRENT_LIST_FILE}")
+
+find_package(Threads REQUIRED)
+
+# every source file is a standalone test registered with ctest,
+# configure with -DCMAKE_C_FLAGS=-fsanitize=thread (or address) to run them under a sanitizer
+file(GLOB TEST_SOURCES ${CMAKE_CURRENT_LIST_DIR}/*.c)
+
+foreach (TEST_SOURCE ${TEST_SOURCES})
+    get_filename_component(TEST_NAME ${TEST_SOURCE} NAME_WE)
+    add_executable(test_${TEST_NAME} ${TEST_SOURCE})
+    target_link_libraries(test_${TEST_NAME} PRIVATE arena Threads::Threads)
+    add_test(NAME ${TEST_NAME} COMMAND test_${TEST_NAME})
+endforeach ()
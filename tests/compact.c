@@ -0,0 +1,182 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <compact.h>
+#include "test.h"
+
+#define RING        10u
+#define CHAIN       5u
+
+struct Node {
+    struct Node *next;
+    struct Node *shared;
+    struct Node *empty;
+    size_t value;
+};
+
+// the pointer of a packed record sits at an offset that is not a multiple of the pointer alignment
+struct Packed {
+    char tag;
+    char next[sizeof(void *)];
+    char tail[2];
+};
+
+static const struct ArenaType nodeType;
+
+static const struct ArenaField nodeFields[] = {
+        {.offset = offsetof(struct Node, next), .type = &nodeType},
+        {.offset = offsetof(struct Node, shared), .type = &nodeType},
+        {.offset = offsetof(struct Node, empty), .type = &nodeType},
+};
+
+static const struct ArenaType nodeType = {
+        .alignment = alignof(struct Node),
+        .size = sizeof(struct Node),
+        .length = 3u,
+        .fields = nodeFields,
+};
+
+static const struct ArenaType packedType;
+
+static const struct ArenaField packedFields[] = {
+        {.offset = offsetof(struct Packed, next), .type = &packedType},
+};
+
+static const struct ArenaType packedType = {
+        .alignment = 1u,
+        .size = sizeof(struct Packed),
+        .length = 1u,
+        .fields = packedFields,
+};
+
+static void checkGraph(void);
+
+static void checkPacked(void);
+
+static struct Packed *nextOf(const struct Packed *packed);
+
+int main() {
+    checkGraph();
+    checkPacked();
+    return 0;
+}
+
+// a ring of nodes all referencing the same node: the ring survives and the shared node is copied once
+void checkGraph(void) {
+    struct Arena *const arena = Arena_withConfig(&(struct ArenaConfig) {.growable = true});
+    struct Node *const shared = Arena_make(arena, struct Node);
+    struct Node *ring[RING];
+    *shared = (struct Node) {.value = 42u};
+
+    for (size_t i = 0u; i < RING; i++) {
+        // dead data between the nodes must not end up in the compacted arena
+        Test_check(NULL != Arena_allocate(arena, 1u, 1u + i * 13u));
+        ring[i] = Arena_make(arena, struct Node);
+        *ring[i] = (struct Node) {.shared = shared, .value = i};
+    }
+
+    for (size_t i = 0u; i < RING; i++) {
+        ring[i]->next = ring[(i + 1u) % RING];
+    }
+
+    void *compacted;
+    struct Arena *const copy = Arena_compact(&nodeType, ring[0], &compacted);
+    const struct Node *const root = compacted;
+    const char *const begin = compacted;
+    const char *const end = begin + (RING + 1u) * sizeof(struct Node);
+
+    // the arena fits the copies exactly, so any layout mismatch would have run out of memory
+    Test_check(Arena_capacity(copy) == (RING + 1u) * sizeof(struct Node));
+    Test_check(0u == Arena_available(copy));
+    Test_check(root != ring[0]);
+
+    const struct Node *node = root;
+    for (size_t i = 0u; i < RING; i++, node = node->next) {
+        Test_check((const char *) node >= begin && (const char *) node < end);
+        Test_check(i == node->value);
+        Test_check(root->shared == node->shared);
+        Test_check(NULL == node->empty);
+    }
+
+    Test_check(root == node);
+    Test_check(root->shared != shared);
+    Test_check((const char *) root->shared >= begin && (const char *) root->shared < end);
+    Test_check(42u == root->shared->value);
+    Test_check(NULL == root->shared->next && NULL == root->shared->shared);
+
+    // the original graph is left untouched
+    for (size_t i = 0u; i < RING; i++) {
+        Test_check(ring[(i + 1u) % RING] == ring[i]->next && shared == ring[i]->shared);
+    }
+
+    Arena_drop(arena);
+    Arena_drop(copy);
+}
+
+// a chain of packed records is laid out contiguously in traversal order
+void checkPacked(void) {
+    struct Arena *const arena = Arena_withConfig(&(struct ArenaConfig) {.growable = true});
+    struct Packed *chain[CHAIN];
+
+    for (size_t i = 0u; i < CHAIN; i++) {
+        Test_check(NULL != Arena_allocate(arena, 1u, 3u));
+        chain[i] = Arena_allocate(arena, 1u, sizeof(struct Packed));
+        chain[i]->tag = (char) ('a' + i);
+        memcpy(chain[i]->tail, "xy", 2u);
+    }
+
+    for (size_t i = 0u; i < CHAIN; i++) {
+        const struct Packed *const next = i + 1u < CHAIN ? chain[i + 1u] : NULL;
+        memcpy(chain[i]->next, &next, sizeof(next));
+    }
+
+    void *compacted;
+    struct Arena *const copy = Arena_compact(&packedType, chain[0], &compacted);
+    Test_check(CHAIN * sizeof(struct Packed) == Arena_capacity(copy));
+    Test_check(0u == Arena_available(copy));
+    const struct Packed *packed = compacted;
+
+    for (size_t i = 0u; i < CHAIN; i++, packed = nextOf(packed)) {
+        Test_check((const char *) compacted + i * sizeof(struct Packed) == (const char *) packed);
+        Test_check((char) ('a' + i) == packed->tag);
+        Test_check(0 == memcmp("xy", packed->tail, 2u));
+    }
+
+    Test_check(NULL == packed);
+    Arena_drop(arena);
+    Arena_drop(copy);
+}
+
+struct Packed *nextOf(const struct Packed *const packed) {
+    struct Packed *next;
+    memcpy(&next, packed->next, sizeof(next));
+    return next;
+}
@@ -0,0 +1,136 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <concurrent_arena.h>
+#include "test.h"
+
+#define THREADS     8u
+#define REQUESTS    20000u
+
+struct Allocation {
+    uintptr_t address;
+    size_t alignment;
+    size_t size;
+    size_t thread;
+};
+
+struct Worker {
+    pthread_t thread;
+    struct ConcurrentArena *arena;
+    struct Allocation *allocations;
+    size_t index;
+};
+
+static uint64_t random64(uint64_t *state);
+
+static void *work(void *argument);
+
+static int compareAllocations(const void *a, const void *b);
+
+// every thread allocates mixed sizes and alignments, ranges must be aligned, zeroed and disjoint
+int main() {
+    struct Allocation *const allocations = malloc(THREADS * REQUESTS * sizeof(*allocations));
+    Test_check(NULL != allocations);
+    size_t capacity = 0u;
+
+    for (size_t i = 0u; i < THREADS; i++) {
+        uint64_t state = 0x9e3779b97f4a7c15u + i;
+
+        for (size_t j = 0u; j < REQUESTS; j++) {
+            struct Allocation *const allocation = &allocations[i * REQUESTS + j];
+            allocation->alignment = 0u == j % 256u ? ARENA_MAX_ALIGNMENT : (size_t) 1u << (random64(&state) % 7u);
+            allocation->size = 1u + random64(&state) % 200u;
+            allocation->thread = i;
+            capacity += allocation->alignment - 1u + allocation->size;
+        }
+    }
+
+    struct ConcurrentArena *const arena = ConcurrentArena_withCapacity(capacity);
+    struct Worker workers[THREADS];
+
+    for (size_t i = 0u; i < THREADS; i++) {
+        workers[i] = (struct Worker) {.arena = arena, .allocations = &allocations[i * REQUESTS], .index = i};
+        Test_check(0 == pthread_create(&workers[i].thread, NULL, work, &workers[i]));
+    }
+
+    for (size_t i = 0u; i < THREADS; i++) {
+        Test_check(0 == pthread_join(workers[i].thread, NULL));
+    }
+
+    qsort(allocations, THREADS * REQUESTS, sizeof(*allocations), compareAllocations);
+
+    for (size_t i = 0u; i < THREADS * REQUESTS; i++) {
+        const struct Allocation *const allocation = &allocations[i];
+        const unsigned char *const memory = (const unsigned char *) allocation->address;
+        Test_check(0u == allocation->address % allocation->alignment);
+        Test_check(i + 1u == THREADS * REQUESTS ||
+                   allocation->address + allocation->size <= allocations[i + 1u].address);
+
+        for (size_t j = 0u; j < allocation->size; j++) {
+            Test_check(memory[j] == (unsigned char) (allocation->thread + 1u));
+        }
+    }
+
+    Test_check(ConcurrentArena_size(arena) <= capacity);
+    ConcurrentArena_drop(arena);
+    free(allocations);
+    return 0;
+}
+
+uint64_t random64(uint64_t *const state) {
+    *state ^= *state << 13u;
+    *state ^= *state >> 7u;
+    *state ^= *state << 17u;
+    return *state;
+}
+
+void *work(void *const argument) {
+    struct Worker *const worker = argument;
+
+    for (size_t i = 0u; i < REQUESTS; i++) {
+        struct Allocation *const allocation = &worker->allocations[i];
+        unsigned char *const memory = ConcurrentArena_allocate(worker->arena, allocation->alignment, allocation->size);
+
+        // the memory is handed out zeroed, then tagged to detect ranges written by other threads
+        for (size_t j = 0u; j < allocation->size; j++) {
+            Test_check(0u == memory[j]);
+            memory[j] = (unsigned char) (worker->index + 1u);
+        }
+
+        allocation->address = (uintptr_t) memory;
+    }
+
+    return NULL;
+}
+
+int compareAllocations(const void *const a, const void *const b) {
+    const struct Allocation *const x = a, *const y = b;
+    return (x->address > y->address) - (x->address < y->address);
+}
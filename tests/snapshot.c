@@ -0,0 +1,102 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <signal.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <arena.h>
+#include "test.h"
+
+struct Node {
+    struct ArenaRelative next;
+    size_t value;
+};
+
+static void checkResizeAborts(struct Arena *arena, void *memory, size_t size);
+
+int main() {
+    char path[] = "/tmp/arena-snapshot-XXXXXX";
+    const int fd = mkstemp(path);
+    Test_check(fd >= 0);
+    close(fd);
+
+    struct Arena *arena = Arena_withCapacity(1024u);
+    struct Node *const first = Arena_make(arena, struct Node);
+    struct Node *const second = Arena_make(arena, struct Node);
+    first->value = 1u;
+    second->value = 2u;
+    ArenaRelative_set(&first->next, second);
+    ArenaRelative_set(&second->next, NULL);
+    Test_check(Arena_save(arena, first, path));
+    Arena_drop(arena);
+
+    const void *root = NULL;
+    arena = Arena_load(path, &root);
+    unlink(path);
+
+    // the platform may not support loading snapshots, callers rebuild their data then
+    if (NULL == arena) {
+        return 0;
+    }
+
+    const struct Node *const loaded = root;
+    const struct Node *const next = ArenaRelative_get(&loaded->next);
+    Test_check(1u == loaded->value);
+    Test_check(NULL != next && 2u == next->value);
+    Test_check(NULL == ArenaRelative_get(&next->next));
+
+    // the mapping is read-only: moving the offset back would hand it out to the next allocation
+    checkResizeAborts(arena, (void *) next, sizeof(*next));
+    Arena_drop(arena);
+    return 0;
+}
+
+// checked runtime errors only abort if NDEBUG is not defined
+void checkResizeAborts(struct Arena *const arena, void *const memory, const size_t size) {
+#if defined(NDEBUG)
+    (void) arena;
+    (void) memory;
+    (void) size;
+#else
+    const pid_t child = fork();
+    Test_check(child >= 0);
+
+    // shrinking the last allocation then writing to the next one
+    if (0 == child) {
+        memset(Arena_resize(arena, memory, alignof(struct Node), size, 1u, NULL), 0, 1u);
+        memset(Arena_allocate(arena, 1u, 1u), 0, 1u);
+        _exit(EXIT_SUCCESS);
+    }
+
+    int status = 0;
+    Test_check(child == waitpid(child, &status, 0));
+    Test_check(WIFSIGNALED(status) && SIGABRT == WTERMSIG(status));
+#endif
+}
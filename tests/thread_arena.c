@@ -0,0 +1,102 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Davide Di Carlo
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <pthread.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <arena.h>
+#include <thread_arena.h>
+#include "test.h"
+
+#define THREADS         8u
+#define ALLOCATIONS     4096u
+#define ALLOCATION_SIZE 24u
+#define BLOCK_CAPACITY  (4u * 1024u)
+
+struct Round {
+    struct ThreadArena *arena;
+    pthread_barrier_t barrier;
+    atomic_size_t blocksAtExit;     // blocks held by the threads when they exit
+};
+
+static void checkGiveBack(size_t maxIdle);
+
+static void *work(void *argument);
+
+int main() {
+    // the reservoir has room for every block, then for just a few of them
+    checkGiveBack(THREADS * ALLOCATIONS);
+    checkGiveBack(2u);
+    return 0;
+}
+
+// exited threads give back every block they held, as far as the reservoir has room for them
+void checkGiveBack(const size_t maxIdle) {
+    struct ArenaReservoir *const reservoir = ArenaReservoir_new(BLOCK_CAPACITY, maxIdle);
+    struct Round round = {
+            .arena = ThreadArena_new(&(struct ArenaConfig) {
+                    .capacity = ARENA_MIN_CAPACITY,
+                    .growable = true,
+                    .reservoir = reservoir,
+            }),
+    };
+    pthread_t threads[THREADS];
+    atomic_init(&round.blocksAtExit, 0u);
+    Test_check(0 == pthread_barrier_init(&round.barrier, NULL, THREADS));
+
+    for (size_t i = 0u; i < THREADS; i++) {
+        Test_check(0 == pthread_create(&threads[i], NULL, work, &round));
+    }
+
+    for (size_t i = 0u; i < THREADS; i++) {
+        Test_check(0 == pthread_join(threads[i], NULL));
+    }
+
+    const size_t held = atomic_load(&round.blocksAtExit);
+    Test_check(held >= THREADS);
+    Test_check((held < maxIdle ? held : maxIdle) == ArenaReservoir_idle(reservoir));
+
+    pthread_barrier_destroy(&round.barrier);
+    ThreadArena_drop(round.arena);
+    ArenaReservoir_drop(reservoir);
+}
+
+void *work(void *const argument) {
+    struct Round *const round = argument;
+    struct Arena *const arena = ThreadArena_get(round->arena);
+    const size_t headCapacity = Arena_capacity(arena);
+
+    for (size_t i = 0u; i < ALLOCATIONS; i++) {
+        memset(Arena_allocate(arena, alignof(max_align_t), ALLOCATION_SIZE), 0xa5, ALLOCATION_SIZE);
+    }
+
+    // no thread exits before all of them hold their blocks, otherwise blocks given back could be taken again
+    atomic_fetch_add(&round->blocksAtExit, (Arena_capacity(arena) - headCapacity) / BLOCK_CAPACITY);
+    pthread_barrier_wait(&round->barrier);
+    return NULL;
+}